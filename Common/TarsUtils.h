@@ -1,10 +1,16 @@
 #pragma once
+#include <bcos-framework/interfaces/crypto/CommonType.h>
 #include <bcos-framework/interfaces/protocol/ServiceDesc.h>
+#include <bcos-framework/libutilities/Error.h>
 #include <bcos-framework/libutilities/Log.h>
 #include <tarscpp/servant/Application.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 
 #define RPCSERVICE_LOG(LEVEL) BCOS_LOG(LEVEL) << "[RPCSERVICE][INITIALIZER]"
 #define GATEWAYSERVICE_LOG(LEVEL) BCOS_LOG(LEVEL) << "[GATEWAYSERVICE][INITIALIZER]"
@@ -31,4 +37,122 @@ inline std::string endPointToString(std::string const& _serviceName, TC_Endpoint
     return _serviceName + "@tcp -h " + _endPoint.getHost() + " -p " +
            boost::lexical_cast<std::string>(_endPoint.getPort());
 }
+
+// the clients of every active endpoint of a service, the proxies and the clients are only created
+// for the new endpoints when the endpoint list of the service changes
+template <class Prx, class Client>
+class EndpointClientCache
+{
+public:
+    using Ptr = std::shared_ptr<EndpointClientCache<Prx, Client>>;
+    using ClientList = std::vector<std::pair<std::string, std::shared_ptr<Client>>>;
+    explicit EndpointClientCache(std::string const& _serviceName)
+      : m_serviceName(_serviceName),
+        m_servicePrx(Application::getCommunicator()->stringToProxy<Prx>(_serviceName))
+    {}
+
+    // the endpoint and the client of every active endpoint
+    ClientList clients()
+    {
+        vector<EndpointInfo> activeEndPoints;
+        vector<EndpointInfo> nactiveEndPoints;
+        m_servicePrx->tars_endpointsAll(activeEndPoints, nactiveEndPoints);
+        std::vector<std::string> endPoints;
+        endPoints.reserve(activeEndPoints.size());
+        for (auto const& endPoint : activeEndPoints)
+        {
+            endPoints.emplace_back(endPointToString(m_serviceName, endPoint.getEndpoint()));
+        }
+        std::lock_guard<std::mutex> l(m_mutex);
+        if (endPoints != m_endPoints)
+        {
+            refresh(endPoints);
+        }
+        return m_clientList;
+    }
+
+private:
+    void refresh(std::vector<std::string> const& _endPoints)
+    {
+        std::map<std::string, std::shared_ptr<Client>> clients;
+        ClientList clientList;
+        clientList.reserve(_endPoints.size());
+        for (auto const& endPoint : _endPoints)
+        {
+            auto it = m_clients.find(endPoint);
+            auto client = (it != m_clients.end()) ?
+                              it->second :
+                              std::make_shared<Client>(
+                                  Application::getCommunicator()->stringToProxy<Prx>(endPoint));
+            clients.emplace(endPoint, client);
+            clientList.emplace_back(endPoint, client);
+        }
+        BCOS_LOG(INFO) << LOG_DESC("EndpointClientCache: the endpoints changed")
+                       << LOG_KV("service", m_serviceName)
+                       << LOG_KV("endPoints", _endPoints.size())
+                       << LOG_KV("cachedEndPoints", m_endPoints.size());
+        m_clients = std::move(clients);
+        m_clientList = std::move(clientList);
+        m_endPoints = _endPoints;
+    }
+
+private:
+    std::string m_serviceName;
+    Prx m_servicePrx;
+    std::mutex m_mutex;
+    std::vector<std::string> m_endPoints;
+    std::map<std::string, std::shared_ptr<Client>> m_clients;
+    ClientList m_clientList;
+};
+
+// decode the hash of the tars interface into _hash, return the error if the hash is not of
+// HashType::size, the request should be rejected
+inline bcos::Error::Ptr toHash(
+    std::vector<tars::Char> const& _tarsHash, bcos::crypto::HashType& _hash)
+{
+    if (_tarsHash.size() != bcos::crypto::HashType::size)
+    {
+        return BCOS_ERROR_PTR(-1, "invalid hash size: " + std::to_string(_tarsHash.size()));
+    }
+    _hash = bcos::crypto::HashType(
+        reinterpret_cast<const bcos::byte*>(_tarsHash.data()), bcos::crypto::HashType::size);
+    return nullptr;
+}
+
+// decode the hash list of the tars interface into _hashList without copying the inner vectors,
+// return the error if any hash is not of HashType::size, the request should be rejected
+inline bcos::Error::Ptr toHashList(std::vector<std::vector<tars::Char>> const& _tarsHashList,
+    bcos::crypto::HashListPtr& _hashList)
+{
+    _hashList = std::make_shared<bcos::crypto::HashList>(_tarsHashList.size());
+    for (size_t i = 0; i < _tarsHashList.size(); ++i)
+    {
+        if (auto error = toHash(_tarsHashList[i], (*_hashList)[i]))
+        {
+            return BCOS_ERROR_PTR(-1, "invalid hash at index " + std::to_string(i) + ", " +
+                                          error->errorMessage());
+        }
+    }
+    return nullptr;
+}
+
+// copy the inner tars struct of the bcos protocol object for the response
+// Note: the inner struct is never moved, the Impl may alias the inner struct of another object,
+// e.g. the transactions of a block, so the use_count of _object doesn't prove the ownership
+template <class Impl, class T>
+inline auto toInner(std::shared_ptr<T> const& _object)
+{
+    using Inner = std::decay_t<decltype(std::declval<Impl const&>().inner())>;
+    if (!_object)
+    {
+        return Inner();
+    }
+    auto impl = dynamic_cast<Impl const*>(_object.get());
+    if (!impl)
+    {
+        BCOS_LOG(ERROR) << LOG_DESC("toInner: unexpected implementation of the protocol object");
+        return Inner();
+    }
+    return Inner(impl->inner());
+}
 }  // namespace bcostars
\ No newline at end of file
@@ -65,8 +65,8 @@ void FrontServiceApp::initService()
     auto gateWay = std::make_shared<bcostars::GatewayServiceClient>(
         gatewayPrx, protocolInitializer->cryptoSuite()->keyFactory());
 
-    m_frontServiceInitializer =
-        std::make_shared<FrontServiceInitializer>(nodeConfig, protocolInitializer, gateWay);
+    m_frontServiceInitializer = std::make_shared<FrontServiceInitializer>(
+        nodeConfig, protocolInitializer, gateWay, FrontDispatchConfig::load(pt));
 
     // get pbft client
     auto pbftPrx = Application::getCommunicator()->stringToProxy<PBFTServicePrx>(
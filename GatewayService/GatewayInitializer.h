@@ -20,6 +20,7 @@
  */
 #pragma once
 #include "Common/TarsUtils.h"
+#include "libinitializer/NodeIDCache.h"
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-framework/interfaces/crypto/KeyInterface.h>
 #include <bcos-framework/interfaces/gateway/GatewayInterface.h>
@@ -36,7 +37,8 @@ public:
     GatewayInitializer(
         std::string const& _configPath, bcos::gateway::GatewayConfig::Ptr _gatewayConfig)
       : m_gatewayConfig(_gatewayConfig),
-        m_keyFactory(std::make_shared<bcos::crypto::KeyFactoryImpl>()),
+        m_keyFactory(std::make_shared<bcos::initializer::NodeIDCache>(
+            std::make_shared<bcos::crypto::KeyFactoryImpl>())),
         m_groupInfoFactory(std::make_shared<bcos::group::GroupInfoFactory>()),
         m_chainNodeInfoFactory(std::make_shared<bcos::group::ChainNodeInfoFactory>())
     {
@@ -20,6 +20,7 @@
  */
 
 #include "LedgerServiceServer.h"
+#include "Common/TarsUtils.h"
 #include <bcos-tars-protocol/Common.h>
 #include <bcos-tars-protocol/ErrorConverter.h>
 #include <bcos-tars-protocol/protocol/BlockImpl.h>
@@ -34,15 +35,13 @@ bcostars::Error LedgerServiceServer::asyncGetBatchTxsByHashList(
     tars::TarsCurrentPtr current)
 {
     current->setResponse(false);
-    auto hashList = std::make_shared<bcos::crypto::HashList>();
-    for (auto const& hash : _txsHashList)
+    bcos::crypto::HashListPtr hashList;
+    if (auto error = toHashList(_txsHashList, hashList))
     {
-        if (hash.size() < bcos::crypto::HashType::size)
-        {
-            continue;
-        }
-        hashList->emplace_back(bcos::crypto::HashType(
-            reinterpret_cast<const bcos::byte*>(hash.data()), bcos::crypto::HashType::size));
+        async_response_asyncGetBatchTxsByHashList(current, toTarsError(error),
+            std::vector<bcostars::Transaction>(),
+            std::map<std::string, std::vector<bcostars::MerkleProofItem>>());
+        return bcostars::Error();
     }
     m_ledger->asyncGetBatchTxsByHashList(hashList, _withProof,
         [current](bcos::Error::Ptr _error, bcos::protocol::TransactionsPtr _txsList,
@@ -51,11 +50,10 @@ bcostars::Error LedgerServiceServer::asyncGetBatchTxsByHashList(
             std::vector<bcostars::Transaction> tarsTxs;
             if (_txsList)
             {
+                tarsTxs.reserve(_txsList->size());
                 for (auto const& tx : *_txsList)
                 {
-                    tarsTxs.emplace_back(
-                        std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(tx)
-                            ->inner());
+                    tarsTxs.emplace_back(toInner<bcostars::protocol::TransactionImpl>(tx));
                 }
             }
             // to tars proof
@@ -91,8 +89,7 @@ bcostars::Error LedgerServiceServer::asyncGetBlockDataByNumber(tars::Int64 _bloc
             bcostars::Block tarsBlock;
             if (_block)
             {
-                tarsBlock =
-                    std::dynamic_pointer_cast<bcostars::protocol::BlockImpl>(_block)->inner();
+                tarsBlock = toInner<bcostars::protocol::BlockImpl>(_block);
             }
             async_response_asyncGetBlockDataByNumber(current, toTarsError(_error), tarsBlock);
         });
@@ -199,11 +196,7 @@ bcostars::Error LedgerServiceServer::asyncGetTransactionReceiptByHash(
             bcostars::TransactionReceipt tarsReceipt;
             if (_receipt)
             {
-                auto mutableReceipt =
-                    std::const_pointer_cast<bcos::protocol::TransactionReceipt>(_receipt);
-                tarsReceipt = std::dynamic_pointer_cast<bcostars::protocol::TransactionReceiptImpl>(
-                    mutableReceipt)
-                                  ->inner();
+                tarsReceipt = toInner<bcostars::protocol::TransactionReceiptImpl>(_receipt);
             }
             // get tars merkle
             vector<bcostars::MerkleProofItem> tarsMerkleItemList;
@@ -88,13 +88,13 @@ void NodeServiceApp::initTarsNodeService()
 void NodeServiceApp::initHandler()
 {
     auto scheduler = m_nodeInitializer->scheduler();
-    auto rpcServicePrx = Application::getCommunicator()->stringToProxy<bcostars::RpcServicePrx>(
+    m_rpcClients = std::make_shared<
+        EndpointClientCache<bcostars::RpcServicePrx, bcostars::RpcServiceClient>>(
         m_nodeInitializer->nodeConfig()->rpcServiceName());
-    scheduler->registerBlockNumberReceiver(
-        [rpcServicePrx, this](bcos::protocol::BlockNumber _blockNumber) {
-            BCOS_LOG(INFO) << "Notify blocknumber: " << _blockNumber;
-            notifyBlockNumberToAllRpcNodes(rpcServicePrx, _blockNumber, [](bcos::Error::Ptr) {});
-        });
+    scheduler->registerBlockNumberReceiver([this](bcos::protocol::BlockNumber _blockNumber) {
+        BCOS_LOG(INFO) << "Notify blocknumber: " << _blockNumber;
+        notifyBlockNumberToAllRpcNodes(_blockNumber);
+    });
     auto schedulerImpl = std::dynamic_pointer_cast<scheduler::SchedulerImpl>(scheduler);
     auto txpool = m_nodeInitializer->txPoolInitializer()->txpool();
     schedulerImpl->registerTransactionNotifier(
@@ -105,26 +105,85 @@ void NodeServiceApp::initHandler()
         });
 }
 
-void NodeServiceApp::notifyBlockNumberToAllRpcNodes(bcostars::RpcServicePrx _rpcPrx,
-    bcos::protocol::BlockNumber _blockNumber, std::function<void(bcos::Error::Ptr)> _callback)
+void NodeServiceApp::notifyBlockNumberToAllRpcNodes(bcos::protocol::BlockNumber _blockNumber)
+{
+    auto latestBlockNumber = m_latestBlockNumber.load();
+    while (latestBlockNumber < _blockNumber &&
+           !m_latestBlockNumber.compare_exchange_weak(latestBlockNumber, _blockNumber))
+    {
+    }
+    notifyLatestBlockNumber();
+}
+
+void NodeServiceApp::onBlockNumberNotified(bcos::protocol::BlockNumber _blockNumber)
 {
-    vector<EndpointInfo> activeEndPoints;
-    vector<EndpointInfo> nactiveEndPoints;
-    _rpcPrx->tars_endpointsAll(activeEndPoints, nactiveEndPoints);
-    if (activeEndPoints.size() == 0)
+    m_notifyingBlockNumber = false;
+    if (m_latestBlockNumber > _blockNumber)
+    {
+        notifyLatestBlockNumber();
+    }
+}
+
+void NodeServiceApp::notifyLatestBlockNumber()
+{
+    if (m_notifyingBlockNumber.exchange(true))
+    {
+        return;
+    }
+    auto blockNumber = m_latestBlockNumber.load();
+    decltype(m_rpcClients->clients()) rpcClients;
+    try
+    {
+        rpcClients = m_rpcClients->clients();
+    }
+    catch (std::exception const& e)
+    {
+        BCOS_LOG(WARNING) << LOG_DESC("notifyBlockNumberToAllRpcNodes: get rpc clients failed")
+                          << LOG_KV("number", blockNumber)
+                          << LOG_KV("error", boost::diagnostic_information(e));
+        onBlockNumberNotified(blockNumber);
+        return;
+    }
+    if (rpcClients.empty())
     {
         BCOS_LOG(TRACE) << LOG_DESC("notifyBlockNumberToAllRpcNodes error for empty connection")
-                        << LOG_KV("number", _blockNumber);
+                        << LOG_KV("number", blockNumber);
+        onBlockNumberNotified(blockNumber);
         return;
     }
-    for (auto const& endPoint : activeEndPoints)
+    // the notification finishes once every client responds or fails to send
+    auto pendingResponses = std::make_shared<std::atomic<size_t>>(rpcClients.size());
+    auto onResponse = [this, pendingResponses, blockNumber]() {
+        if (--(*pendingResponses) > 0)
+        {
+            return;
+        }
+        onBlockNumberNotified(blockNumber);
+    };
+    for (auto const& it : rpcClients)
     {
-        auto endPointStr = endPointToString(
-            m_nodeInitializer->nodeConfig()->rpcServiceName(), endPoint.getEndpoint());
-        auto servicePrx =
-            Application::getCommunicator()->stringToProxy<bcostars::RpcServicePrx>(endPointStr);
-        auto serviceClient = std::make_shared<bcostars::RpcServiceClient>(servicePrx);
-        serviceClient->asyncNotifyBlockNumber(m_nodeInitializer->nodeConfig()->groupId(),
-            m_nodeInitializer->nodeConfig()->nodeName(), _blockNumber, _callback);
+        try
+        {
+            it.second->asyncNotifyBlockNumber(m_nodeInitializer->nodeConfig()->groupId(),
+                m_nodeInitializer->nodeConfig()->nodeName(), blockNumber,
+                [onResponse, blockNumber, endPoint = it.first](bcos::Error::Ptr _error) {
+                    if (_error)
+                    {
+                        BCOS_LOG(WARNING) << LOG_DESC("notifyBlockNumberToAllRpcNodes error")
+                                          << LOG_KV("endPoint", endPoint)
+                                          << LOG_KV("number", blockNumber)
+                                          << LOG_KV("code", _error->errorCode())
+                                          << LOG_KV("msg", _error->errorMessage());
+                    }
+                    onResponse();
+                });
+        }
+        catch (std::exception const& e)
+        {
+            BCOS_LOG(WARNING) << LOG_DESC("notifyBlockNumberToAllRpcNodes exception")
+                              << LOG_KV("endPoint", it.first) << LOG_KV("number", blockNumber)
+                              << LOG_KV("error", boost::diagnostic_information(e));
+            onResponse();
+        }
     }
 }
@@ -61,8 +61,13 @@ protected:
     virtual void initNodeService();
     virtual void initTarsNodeService();
     void initHandler();
-    void notifyBlockNumberToAllRpcNodes(bcostars::RpcServicePrx _rpcPrx,
-        bcos::protocol::BlockNumber _blockNumber, std::function<void(bcos::Error::Ptr)> _callback);
+    // the block numbers notified while the rpc nodes are being notified are coalesced, only the
+    // latest one is sent after the in-flight notification completes
+    void notifyBlockNumberToAllRpcNodes(bcos::protocol::BlockNumber _blockNumber);
+    void notifyLatestBlockNumber();
+    // clear the in-flight flag, then notify the blocks committed during the notification of
+    // _blockNumber, which the notifyBlockNumberToAllRpcNodes calls have skipped
+    void onBlockNumberNotified(bcos::protocol::BlockNumber _blockNumber);
 
 private:
     bcos::BoostLogInitializer::Ptr m_logInitializer;
@@ -70,5 +75,9 @@ private:
     std::string m_genesisConfigPath;
     std::string m_privateKeyPath;
     bcos::initializer::Initializer::Ptr m_nodeInitializer;
+
+    EndpointClientCache<bcostars::RpcServicePrx, bcostars::RpcServiceClient>::Ptr m_rpcClients;
+    std::atomic<bcos::protocol::BlockNumber> m_latestBlockNumber = {-1};
+    std::atomic_bool m_notifyingBlockNumber = {false};
 };
 }  // namespace bcostars
\ No newline at end of file
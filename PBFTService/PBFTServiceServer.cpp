@@ -56,7 +56,7 @@ Error PBFTServiceServer::asyncNoteUnSealedTxsSize(
     tars::Int64 _unsealedTxsSize, tars::TarsCurrentPtr _current)
 {
     _current->setResponse(false);
-    m_pbftInitializer->sealer()->asyncNoteUnSealedTxsSize(
+    m_pbftInitializer->asyncNoteUnSealedTxsSize(
         _unsealedTxsSize, [_current](bcos::Error::Ptr _error) {
             async_response_asyncNoteUnSealedTxsSize(_current, toTarsError(_error));
         });
@@ -85,6 +85,7 @@ bcostars::Error PBFTServiceServer::asyncNotifyBlockSyncMessage(std::string const
     _current->setResponse(false);
     auto nodeId = m_pbftInitializer->keyFactory()->createKey(
         bcos::bytesConstRef((const bcos::byte*)_nodeId.data(), _nodeId.size()));
+    m_pbftInitializer->syncRateStatistics()->onSyncMessage(nodeId, _data.size());
     m_pbftInitializer->blockSync()->asyncNotifyBlockSyncMessage(nullptr, _uuid, nodeId,
         bcos::bytesConstRef((const bcos::byte*)_data.data(), _data.size()),
         [_current](bcos::Error::Ptr _error) {
@@ -128,7 +129,7 @@ Error PBFTServiceServer::asyncSubmitProposal(bool _containSysTxs,
 bcostars::Error PBFTServiceServer::asyncGetSyncInfo(std::string&, tars::TarsCurrentPtr _current)
 {
     _current->setResponse(false);
-    m_pbftInitializer->blockSync()->asyncGetSyncInfo(
+    m_pbftInitializer->asyncGetSyncInfo(
         [_current](bcos::Error::Ptr _error, std::string const& _syncInfo) {
             async_response_asyncGetSyncInfo(_current, toTarsError(_error), _syncInfo);
         });
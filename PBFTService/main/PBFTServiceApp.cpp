@@ -91,7 +91,8 @@ void PBFTServiceApp::initService()
     // TODO: create tikv storage
     m_pbftInitializer =
         std::make_shared<PBFTInitializer>(bcos::initializer::NodeArchitectureType::MAX, nodeConfig,
-            protocolInitializer, txpool, ledger, scheduler, nullptr, frontService);
+            protocolInitializer, txpool, ledger, scheduler, nullptr, frontService,
+            PBFTTuningConfig::load(pt));
     m_pbftInitializer->init();
     m_pbftInitializer->start();
 }
\ No newline at end of file
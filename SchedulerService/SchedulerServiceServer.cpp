@@ -19,6 +19,7 @@
  * @date 2021-10-18
  */
 #include "SchedulerServiceServer.h"
+#include "Common/TarsUtils.h"
 #include <bcos-tars-protocol/ErrorConverter.h>
 #include <bcos-tars-protocol/protocol/TransactionImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionReceiptImpl.h>
@@ -35,9 +36,7 @@ bcostars::Error SchedulerServiceServer::call(
             bcostars::TransactionReceipt tarsReceipt;
             if (_receipt)
             {
-                tarsReceipt =
-                    std::dynamic_pointer_cast<bcostars::protocol::TransactionReceiptImpl>(_receipt)
-                        ->inner();
+                tarsReceipt = toInner<bcostars::protocol::TransactionReceiptImpl>(_receipt);
             }
             async_response_call(current, toTarsError(_error), tarsReceipt);
         });
@@ -5,11 +5,14 @@ bcostars::Error TxPoolServiceServer::asyncFillBlock(const vector<vector<tars::Ch
     vector<bcostars::Transaction>& filled, tars::TarsCurrentPtr current)
 {
     current->setResponse(false);
-    auto hashList = std::make_shared<std::vector<bcos::crypto::HashType>>();
-    for (auto const& hashData : txHashs)
+    bcos::crypto::HashListPtr hashList;
+    if (auto error = toHashList(txHashs, hashList))
     {
-        hashList->push_back(bcos::crypto::HashType(
-            reinterpret_cast<const bcos::byte*>(hashData.data()), hashData.size()));
+        TXPOOLSERVICE_LOG(WARNING) << LOG_DESC("asyncFillBlock: invalid request")
+                                   << LOG_KV("msg", error->errorMessage());
+        async_response_asyncFillBlock(
+            current, toTarsError(error), std::vector<bcostars::Transaction>());
+        return bcostars::Error();
     }
 
     m_txpoolInitializer->txpool()->asyncFillBlock(
@@ -23,10 +26,10 @@ bcostars::Error TxPoolServiceServer::asyncFillBlock(const vector<vector<tars::Ch
                     << LOG_KV("msg", error->errorMessage());
                 return;
             }
-            for (auto tx : *txs)
+            txList.reserve(txs->size());
+            for (auto const& tx : *txs)
             {
-                txList.push_back(
-                    std::dynamic_pointer_cast<bcostars::protocol::TransactionImpl>(tx)->inner());
+                txList.emplace_back(toInner<bcostars::protocol::TransactionImpl>(tx));
             }
 
             async_response_asyncFillBlock(current, toTarsError(error), txList);
@@ -41,14 +44,22 @@ bcostars::Error TxPoolServiceServer::asyncMarkTxs(const vector<vector<tars::Char
     tars::TarsCurrentPtr current)
 {
     current->setResponse(false);
-    auto hashList = std::make_shared<std::vector<bcos::crypto::HashType>>();
-    for (auto hashData : txHashs)
+    bcos::crypto::HashListPtr hashList;
+    if (auto error = toHashList(txHashs, hashList))
     {
-        hashList->push_back(bcos::crypto::HashType(
-            reinterpret_cast<const bcos::byte*>(hashData.data()), hashData.size()));
+        TXPOOLSERVICE_LOG(WARNING) << LOG_DESC("asyncMarkTxs: invalid request")
+                                   << LOG_KV("msg", error->errorMessage());
+        async_response_asyncMarkTxs(current, toTarsError(error));
+        return bcostars::Error();
+    }
+    bcos::crypto::HashType batchHash;
+    if (auto error = toHash(_batchHash, batchHash))
+    {
+        TXPOOLSERVICE_LOG(WARNING) << LOG_DESC("asyncMarkTxs: invalid batchHash")
+                                   << LOG_KV("msg", error->errorMessage());
+        async_response_asyncMarkTxs(current, toTarsError(error));
+        return bcostars::Error();
     }
-    auto batchHash = bcos::crypto::HashType(
-        reinterpret_cast<const bcos::byte*>(_batchHash.data()), _batchHash.size());
     m_txpoolInitializer->txpool()->asyncMarkTxs(
         hashList, sealedFlag, _batchId, batchHash, [current](bcos::Error::Ptr error) {
             async_response_asyncMarkTxs(current, toTarsError(error));
@@ -102,11 +113,17 @@ bcostars::Error TxPoolServiceServer::asyncSealTxs(tars::Int64 txsLimit,
 {
     current->setResponse(false);
 
-    auto bcosAvoidTxs = std::make_shared<bcos::txpool::TxsHashSet>();
-    for (auto tx : avoidTxs)
+    bcos::crypto::HashListPtr avoidTxsHash;
+    if (auto error = toHashList(avoidTxs, avoidTxsHash))
     {
-        bcosAvoidTxs->insert(bcos::crypto::HashType(bcos::bytes(tx.begin(), tx.end())));
+        TXPOOLSERVICE_LOG(WARNING) << LOG_DESC("asyncSealTxs: invalid request")
+                                   << LOG_KV("msg", error->errorMessage());
+        async_response_asyncSealTxs(
+            current, toTarsError(error), bcostars::Block(), bcostars::Block());
+        return bcostars::Error();
     }
+    auto bcosAvoidTxs = std::make_shared<bcos::txpool::TxsHashSet>(
+        avoidTxsHash->begin(), avoidTxsHash->end());
 
     m_txpoolInitializer->txpool()->asyncSealTxs(txsLimit, bcosAvoidTxs,
         [current](bcos::Error::Ptr error, bcos::protocol::Block::Ptr _txsList,
@@ -121,8 +138,8 @@ bcostars::Error TxPoolServiceServer::asyncSealTxs(tars::Int64 txsLimit,
                 return;
             }
             async_response_asyncSealTxs(current, toTarsError(error),
-                std::dynamic_pointer_cast<bcostars::protocol::BlockImpl>(_txsList)->inner(),
-                std::dynamic_pointer_cast<bcostars::protocol::BlockImpl>(_sysTxsList)->inner());
+                toInner<bcostars::protocol::BlockImpl>(_txsList),
+                toInner<bcostars::protocol::BlockImpl>(_sysTxsList));
         });
 
     return bcostars::Error();
@@ -133,7 +150,7 @@ bcostars::Error TxPoolServiceServer::asyncSubmit(const vector<tars::Char>& tx,
 {
     current->setResponse(false);
     auto dataPtr = std::make_shared<bcos::bytes>(tx.begin(), tx.end());
-    m_txpoolInitializer->txpool()->asyncSubmit(dataPtr,
+    m_txpoolInitializer->asyncSubmit(dataPtr,
         [current](bcos::Error::Ptr error, bcos::protocol::TransactionSubmitResult::Ptr result) {
             async_response_asyncSubmit(current, toTarsError(error),
                 std::dynamic_pointer_cast<bcostars::protocol::TransactionSubmitResultImpl>(result)
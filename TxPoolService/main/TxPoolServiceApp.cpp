@@ -74,6 +74,8 @@ void TxPoolServiceApp::initService()
     // create txpoolInitializer
     m_txpoolInitializer =
         std::make_shared<TxPoolInitializer>(nodeConfig, protocolInitializer, frontService, ledger);
+    m_txpoolInitializer->setBatchVerifier(
+        TxBatchVerifier::build(pt, protocolInitializer->blockFactory()->transactionFactory()));
 
     // init the txpool
     auto pbftPrx = Application::getCommunicator()->stringToProxy<PBFTServicePrx>(
@@ -19,6 +19,7 @@
  * @date 2021-10-28
  */
 #include "LocalNodeInitializer.h"
+#include <bcos-framework/interfaces/sync/BlockSyncInterface.h>
 #include <bcos-framework/libtool/NodeConfig.h>
 #include <bcos-gateway/GatewayFactory.h>
 #include <bcos-gateway/libamop/LocalTopicManager.h>
@@ -29,6 +30,61 @@ using namespace bcos::gateway;
 using namespace bcos::rpc;
 using namespace bcos::tool;
 
+namespace
+{
+// the block sync exposed to the rpc, the sync info carries the download and commit rates
+class RpcBlockSync : public bcos::sync::BlockSyncInterface
+{
+public:
+    explicit RpcBlockSync(PBFTInitializer::Ptr _pbftInitializer)
+      : m_pbftInitializer(std::move(_pbftInitializer)),
+        m_blockSync(m_pbftInitializer->blockSync())
+    {}
+    ~RpcBlockSync() override {}
+
+    void start() override { m_blockSync->start(); }
+    void stop() override { m_blockSync->stop(); }
+
+    void asyncNotifyNewBlock(bcos::ledger::LedgerConfig::Ptr _ledgerConfig,
+        std::function<void(bcos::Error::Ptr)> _onRecv) override
+    {
+        m_blockSync->asyncNotifyNewBlock(_ledgerConfig, _onRecv);
+    }
+
+    void asyncNotifyCommittedIndex(bcos::protocol::BlockNumber _number,
+        std::function<void(bcos::Error::Ptr _error)> _onRecv) override
+    {
+        m_blockSync->asyncNotifyCommittedIndex(_number, _onRecv);
+    }
+
+    void asyncGetSyncInfo(
+        std::function<void(bcos::Error::Ptr, std::string)> _onGetSyncInfo) override
+    {
+        m_pbftInitializer->asyncGetSyncInfo(
+            [_onGetSyncInfo](bcos::Error::Ptr _error, std::string const& _syncInfo) {
+                _onGetSyncInfo(_error, _syncInfo);
+            });
+    }
+
+    void asyncNotifyBlockSyncMessage(bcos::Error::Ptr _error, std::string const& _uuid,
+        bcos::crypto::NodeIDPtr _nodeID, bcos::bytesConstRef _data,
+        std::function<void(bcos::Error::Ptr _error)> _onRecv) override
+    {
+        m_blockSync->asyncNotifyBlockSyncMessage(_error, _uuid, _nodeID, _data, _onRecv);
+    }
+
+    void notifyConnectedNodes(bcos::crypto::NodeIDSet const& _connectedNodes,
+        std::function<void(bcos::Error::Ptr)> _onRecvResponse) override
+    {
+        m_blockSync->notifyConnectedNodes(_connectedNodes, _onRecvResponse);
+    }
+
+private:
+    PBFTInitializer::Ptr m_pbftInitializer;
+    bcos::sync::BlockSync::Ptr m_blockSync;
+};
+}  // namespace
+
 void LocalNodeInitializer::init(std::string const& _configFilePath, std::string const& _genesisFile)
 {
     boost::property_tree::ptree pt;
@@ -58,7 +114,8 @@ void LocalNodeInitializer::init(std::string const& _configFilePath, std::string
     auto nodeService =
         std::make_shared<NodeService>(m_nodeInitializer->ledger(), m_nodeInitializer->scheduler(),
             m_nodeInitializer->txPoolInitializer()->txpool(), pbftInitializer->pbft(),
-            pbftInitializer->blockSync(), m_nodeInitializer->protocolInitializer()->blockFactory());
+            std::make_shared<RpcBlockSync>(pbftInitializer),
+            m_nodeInitializer->protocolInitializer()->blockFactory());
     // create rpc
     RpcFactory rpcFactory(nodeConfig->chainId(), m_gateway, keyFactory);
     rpcFactory.setNodeConfig(nodeConfig);
@@ -0,0 +1,69 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decide the size of the sealed proposals from the load of the node
+ * @file AdaptiveSealPolicy.h
+ * @date 2021-11-26
+ */
+#pragma once
+#include "libinitializer/ConsensusPhaseStatistics.h"
+#include <algorithm>
+#include <atomic>
+
+namespace bcos::initializer
+{
+// the sealer seals a proposal once it holds maxTxsToSeal transactions, or once min_seal_time
+// expires with some transactions, the policy picks maxTxsToSeal:
+// 1. light load: maxTxsToSeal never drops below 1/c_minSealRatio of the block_tx_count_limit, the
+// few unsealed transactions are sealed by min_seal_time instead of as a stream of tiny blocks
+// 2. the proposal will wait for the heights in the pipeline anyway: when the consensus round trip
+// plus the execution of the recent heights exceed min_seal_time, the proposal collects the
+// transactions arriving meanwhile
+// 3. heavy load: the unsealed transactions exceed the block_tx_count_limit, full blocks are sealed
+class AdaptiveSealPolicy
+{
+public:
+    using Ptr = std::shared_ptr<AdaptiveSealPolicy>;
+    AdaptiveSealPolicy(ConsensusPhaseStatistics::Ptr _phaseStatistics, uint64_t _minSealTime)
+      : m_phaseStatistics(std::move(_phaseStatistics)), m_minSealTime(_minSealTime)
+    {}
+
+    void onUnsealedTxsSize(size_t _unsealedTxsSize) { m_unsealedTxsSize = _unsealedTxsSize; }
+
+    // _maxTxsToSeal: the block_tx_count_limit requested by the consensus
+    size_t maxTxsToSeal(size_t _maxTxsToSeal) const
+    {
+        size_t unsealedTxsSize = m_unsealedTxsSize;
+        auto pipelineTime =
+            m_phaseStatistics->averageSealToCommit() + m_phaseStatistics->averageCommitToStore();
+        size_t expectedTxs = unsealedTxsSize;
+        if (m_minSealTime > 0 && pipelineTime > (int64_t)m_minSealTime)
+        {
+            // the pending transactions arrived within about one min_seal_time
+            expectedTxs = unsealedTxsSize * ((pipelineTime + m_minSealTime - 1) / m_minSealTime);
+        }
+        auto maxTxs = std::max<size_t>(_maxTxsToSeal, 1);
+        auto minTxs = std::max<size_t>(maxTxs / c_minSealRatio, 1);
+        return std::clamp<size_t>(expectedTxs, minTxs, maxTxs);
+    }
+
+private:
+    ConsensusPhaseStatistics::Ptr m_phaseStatistics;
+    uint64_t m_minSealTime;
+    std::atomic<size_t> m_unsealedTxsSize = {0};
+    // the floor of maxTxsToSeal is block_tx_count_limit / c_minSealRatio
+    static constexpr size_t c_minSealRatio = 10;
+};
+}  // namespace bcos::initializer
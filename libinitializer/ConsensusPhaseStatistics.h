@@ -0,0 +1,131 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the per-height timings of the consensus phases
+ * @file ConsensusPhaseStatistics.h
+ * @date 2021-11-25
+ */
+#pragma once
+#include "libinitializer/Common.h"
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace bcos::initializer
+{
+// the phases of one height observed by the notifiers of PBFT:
+// seal: the sealer is notified to seal the proposal of the height
+// commit: the proposal reaches the commit quorum, the pre-prepare, prepare and commit phases
+// store: the block is executed by the scheduler, checkpointed and stored
+// the heights within the water mark are sealed before the lower heights are stored, the
+// overlapped heights are reported as inflight
+class ConsensusPhaseStatistics
+{
+public:
+    using Ptr = std::shared_ptr<ConsensusPhaseStatistics>;
+    ConsensusPhaseStatistics() = default;
+
+    void onSealNotified(
+        bcos::protocol::BlockNumber _startIndex, bcos::protocol::BlockNumber _endIndex)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> l(m_mutex);
+        for (auto index = _startIndex; index <= _endIndex; ++index)
+        {
+            // the seal of the height may be notified again after the sealer is reset, the
+            // phases of the new proposal replace the stale ones
+            m_phases.insert_or_assign(index, PhaseTimes{now, std::nullopt});
+        }
+    }
+
+    void onCommitted(bcos::protocol::BlockNumber _index)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> l(m_mutex);
+        auto it = m_phases.find(_index);
+        if (it != m_phases.end() && !it->second.commitT)
+        {
+            it->second.commitT = now;
+        }
+    }
+
+    void onStored(bcos::protocol::BlockNumber _number)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::optional<PhaseTimes> phases;
+        size_t inflight = 0;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            auto it = m_phases.find(_number);
+            if (it != m_phases.end())
+            {
+                phases = it->second;
+            }
+            // the heights below are stored or synced from the other nodes
+            m_phases.erase(m_phases.begin(), m_phases.upper_bound(_number));
+            inflight = m_phases.size();
+        }
+        if (!phases)
+        {
+            return;
+        }
+        auto sealAndConsensus = phases->commitT ? toMs(*phases->commitT - phases->sealT) : -1;
+        auto executeAndStore = phases->commitT ? toMs(now - *phases->commitT) : -1;
+        if (phases->commitT)
+        {
+            updateAverage(m_avgSealToCommit, sealAndConsensus);
+            updateAverage(m_avgCommitToStore, executeAndStore);
+        }
+        INITIALIZER_LOG(INFO) << LOG_BADGE("METRIC") << LOG_DESC("consensus phases")
+                              << LOG_KV("number", _number)
+                              << LOG_KV("sealToCommit(ms)", sealAndConsensus)
+                              << LOG_KV("commitToStore(ms)", executeAndStore)
+                              << LOG_KV("total(ms)", toMs(now - phases->sealT))
+                              << LOG_KV("inflight", inflight);
+    }
+
+    // the moving averages of the recent heights in ms, 0 before the first block is stored
+    int64_t averageSealToCommit() const { return m_avgSealToCommit; }
+    int64_t averageCommitToStore() const { return m_avgCommitToStore; }
+
+private:
+    struct PhaseTimes
+    {
+        std::chrono::steady_clock::time_point sealT;
+        std::optional<std::chrono::steady_clock::time_point> commitT;
+    };
+
+    static int64_t toMs(std::chrono::steady_clock::duration _duration)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(_duration).count();
+    }
+
+    // the new sample weighs 1/8, the onStored of the heights is called in order
+    static void updateAverage(std::atomic<int64_t>& _average, int64_t _sample)
+    {
+        auto average = _average.load();
+        _average = (average == 0) ? _sample : (average * 7 + _sample) / 8;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::map<bcos::protocol::BlockNumber, PhaseTimes> m_phases;
+    std::atomic<int64_t> m_avgSealToCommit = {0};
+    std::atomic<int64_t> m_avgCommitToStore = {0};
+};
+}  // namespace bcos::initializer
@@ -26,9 +26,20 @@ using namespace bcos::front;
 
 FrontServiceInitializer::FrontServiceInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
     bcos::initializer::ProtocolInitializer::Ptr _protocolInitializer,
-    bcos::gateway::GatewayInterface::Ptr _gateWay)
+    bcos::gateway::GatewayInterface::Ptr _gateWay, FrontDispatchConfig::Ptr _dispatchConfig)
   : m_nodeConfig(_nodeConfig), m_protocolInitializer(_protocolInitializer), m_gateWay(_gateWay)
 {
+    // PBFT > BlockSync > TxsSync
+    m_pbftDispatcher =
+        std::make_shared<ModuleDispatcher>("pbftDispatch", c_pbftWorkerNum, 0);
+    m_blockSyncDispatcher = std::make_shared<ModuleDispatcher>(
+        "syncDispatch", _dispatchConfig->blockSyncWorkerNum, 5);
+    m_txsSyncQueue = std::make_shared<PeerMessageQueue>("txsDispatch",
+        _dispatchConfig->txsSyncWorkerNum, 10, _dispatchConfig->txsSyncPeerQueueSize);
+    m_reportTimer = std::make_shared<Timer>(m_reportInterval, "frontDispatchReport");
+    m_reportTimer->registerTimeoutHandler(
+        boost::bind(&FrontServiceInitializer::reportDispatchQueues, this));
+
     auto frontServiceFactory = std::make_shared<FrontServiceFactory>();
     frontServiceFactory->setGatewayInterface(m_gateWay);
 
@@ -48,6 +59,7 @@ void FrontServiceInitializer::start()
     FRONTSERVICE_LOG(INFO) << LOG_DESC("Start the front service");
     m_running = true;
     m_front->start();
+    m_reportTimer->start();
 }
 void FrontServiceInitializer::stop()
 {
@@ -58,6 +70,7 @@ void FrontServiceInitializer::stop()
     }
     FRONTSERVICE_LOG(INFO) << LOG_DESC("Stop the front service");
     m_running = false;
+    m_reportTimer->stop();
     m_front->stop();
 }
 
@@ -67,61 +80,103 @@ void FrontServiceInitializer::init(bcos::consensus::ConsensusInterface::Ptr _pbf
     initMsgHandlers(_pbft, _blockSync, _txpool);
 }
 
+size_t FrontServiceInitializer::dispatchQueueSize(bcos::protocol::ModuleID _moduleID) const
+{
+    switch (_moduleID)
+    {
+    case bcos::protocol::ModuleID::PBFT:
+        return m_pbftDispatcher->pendingTasks();
+    case bcos::protocol::ModuleID::BlockSync:
+        return m_blockSyncDispatcher->pendingTasks();
+    case bcos::protocol::ModuleID::TxsSync:
+        return m_txsSyncQueue->pendingMessages();
+    default:
+        return 0;
+    }
+}
+
+void FrontServiceInitializer::reportDispatchQueues()
+{
+    FRONTSERVICE_LOG(INFO) << LOG_BADGE("METRIC") << LOG_DESC("front dispatch queues")
+                           << LOG_KV("pbft", m_pbftDispatcher->pendingTasks())
+                           << LOG_KV("blockSync", m_blockSyncDispatcher->pendingTasks())
+                           << LOG_KV("txsSync", m_txsSyncQueue->pendingMessages())
+                           << LOG_KV("txsSyncDropped", m_txsSyncQueue->droppedMessages());
+    m_reportTimer->restart();
+}
+
 
 void FrontServiceInitializer::initMsgHandlers(bcos::consensus::ConsensusInterface::Ptr _pbft,
     bcos::sync::BlockSyncInterface::Ptr _blockSync, bcos::txpool::TxPoolInterface::Ptr _txpool)
 {
     // register the message dispatcher handler to the frontService
     // register the message dispatcher for PBFT module
-    m_front->registerModuleMessageDispatcher(
-        bcos::protocol::ModuleID::PBFT, [_pbft](bcos::crypto::NodeIDPtr _nodeID,
-                                            const std::string& _id, bcos::bytesConstRef _data) {
-            _pbft->asyncNotifyConsensusMessage(
-                nullptr, _id, _nodeID, _data, [](bcos::Error::Ptr _error) {
-                    if (_error)
-                    {
-                        FRONTSERVICE_LOG(WARNING)
-                            << LOG_DESC("registerModuleMessageDispatcher failed")
-                            << LOG_KV("code", _error->errorCode())
-                            << LOG_KV("msg", _error->errorMessage());
-                    }
-                });
+    m_front->registerModuleMessageDispatcher(bcos::protocol::ModuleID::PBFT,
+        [_pbft, dispatcher = m_pbftDispatcher](bcos::crypto::NodeIDPtr _nodeID,
+            const std::string& _id, bcos::bytesConstRef _data) {
+            // the only copy of the message, moved into the task
+            bcos::bytes data(_data.begin(), _data.end());
+            dispatcher->enqueue([_pbft, _nodeID, _id, data = std::move(data)]() {
+                _pbft->asyncNotifyConsensusMessage(
+                    nullptr, _id, _nodeID, bcos::ref(data), [](bcos::Error::Ptr _error) {
+                        if (_error)
+                        {
+                            FRONTSERVICE_LOG(WARNING)
+                                << LOG_DESC("registerModuleMessageDispatcher failed")
+                                << LOG_KV("code", _error->errorCode())
+                                << LOG_KV("msg", _error->errorMessage());
+                        }
+                    });
+            });
         });
     FRONTSERVICE_LOG(INFO) << LOG_DESC(
         "registerModuleMessageDispatcher for the consensus module success");
 
     // register the message dispatcher for the txsSync module
-    m_front->registerModuleMessageDispatcher(
-        bcos::protocol::ModuleID::TxsSync, [_txpool](bcos::crypto::NodeIDPtr _nodeID,
-                                               std::string const& _id, bcos::bytesConstRef _data) {
-            _txpool->asyncNotifyTxsSyncMessage(
-                nullptr, _id, _nodeID, _data, [_id](bcos::Error::Ptr _error) {
-                    if (_error)
-                    {
-                        FRONTSERVICE_LOG(WARNING) << LOG_DESC("asyncNotifyTxsSyncMessage failed")
-                                                  << LOG_KV("code", _error->errorCode())
-                                                  << LOG_KV("msg", _error->errorMessage());
-                    }
-                });
+    m_front->registerModuleMessageDispatcher(bcos::protocol::ModuleID::TxsSync,
+        [_txpool, queue = m_txsSyncQueue](bcos::crypto::NodeIDPtr _nodeID,
+            std::string const& _id, bcos::bytesConstRef _data) {
+            // the only copy of the message, moved into the task
+            bcos::bytes data(_data.begin(), _data.end());
+            queue->enqueue(_nodeID, [_txpool, _nodeID, _id, data = std::move(data)]() {
+                _txpool->asyncNotifyTxsSyncMessage(
+                    nullptr, _id, _nodeID, bcos::ref(data), [_id](bcos::Error::Ptr _error) {
+                        if (_error)
+                        {
+                            FRONTSERVICE_LOG(WARNING)
+                                << LOG_DESC("asyncNotifyTxsSyncMessage failed")
+                                << LOG_KV("code", _error->errorCode())
+                                << LOG_KV("msg", _error->errorMessage());
+                        }
+                    });
+            });
         });
     FRONTSERVICE_LOG(INFO) << LOG_DESC(
         "registerModuleMessageDispatcher for the txsSync module success");
 
     // register the message dispatcher for the block sync module
     m_front->registerModuleMessageDispatcher(bcos::protocol::ModuleID::BlockSync,
-        [_blockSync](
+        [_blockSync, dispatcher = m_blockSyncDispatcher, syncRateStatistics = m_syncRateStatistics](
             bcos::crypto::NodeIDPtr _nodeID, std::string const& _id, bcos::bytesConstRef _data) {
-            _blockSync->asyncNotifyBlockSyncMessage(
-                nullptr, _id, _nodeID, _data, [_id, _nodeID](bcos::Error::Ptr _error) {
-                    if (_error)
-                    {
-                        FRONTSERVICE_LOG(WARNING)
-                            << LOG_DESC("asyncNotifyBlockSyncMessage failed")
-                            << LOG_KV("peer", _nodeID->shortHex()) << LOG_KV("id", _id)
-                            << LOG_KV("code", _error->errorCode())
-                            << LOG_KV("msg", _error->errorMessage());
-                    }
-                });
+            if (syncRateStatistics)
+            {
+                syncRateStatistics->onSyncMessage(_nodeID, _data.size());
+            }
+            // the only copy of the message, moved into the task
+            bcos::bytes data(_data.begin(), _data.end());
+            dispatcher->enqueue([_blockSync, _nodeID, _id, data = std::move(data)]() {
+                _blockSync->asyncNotifyBlockSyncMessage(nullptr, _id, _nodeID, bcos::ref(data),
+                    [_id, _nodeID](bcos::Error::Ptr _error) {
+                        if (_error)
+                        {
+                            FRONTSERVICE_LOG(WARNING)
+                                << LOG_DESC("asyncNotifyBlockSyncMessage failed")
+                                << LOG_KV("peer", _nodeID->shortHex()) << LOG_KV("id", _id)
+                                << LOG_KV("code", _error->errorCode())
+                                << LOG_KV("msg", _error->errorMessage());
+                        }
+                    });
+            });
         });
     FRONTSERVICE_LOG(INFO) << LOG_DESC(
         "registerModuleMessageDispatcher for the BlockSync module success");
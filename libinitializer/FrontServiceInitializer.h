@@ -20,12 +20,16 @@
  */
 #pragma once
 #include "Common/TarsUtils.h"
+#include "libinitializer/ModuleDispatcher.h"
+#include "libinitializer/PeerMessageQueue.h"
 #include "libinitializer/ProtocolInitializer.h"
+#include "libinitializer/SyncRateStatistics.h"
 #include <bcos-framework/interfaces/consensus/ConsensusInterface.h>
 #include <bcos-framework/interfaces/gateway/GatewayInterface.h>
 #include <bcos-framework/interfaces/sync/BlockSyncInterface.h>
 #include <bcos-framework/interfaces/txpool/TxPoolInterface.h>
 #include <bcos-framework/libtool/NodeConfig.h>
+#include <bcos-framework/libutilities/Timer.h>
 #include <bcos-front/FrontServiceFactory.h>
 
 namespace bcos
@@ -38,7 +42,8 @@ public:
     using Ptr = std::shared_ptr<FrontServiceInitializer>;
     FrontServiceInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
         bcos::initializer::ProtocolInitializer::Ptr _protocolInitializer,
-        bcos::gateway::GatewayInterface::Ptr _gateWay);
+        bcos::gateway::GatewayInterface::Ptr _gateWay,
+        FrontDispatchConfig::Ptr _dispatchConfig = std::make_shared<FrontDispatchConfig>());
     virtual ~FrontServiceInitializer() { stop(); }
 
     virtual void init(bcos::consensus::ConsensusInterface::Ptr _pbft,
@@ -49,10 +54,21 @@ public:
     bcos::front::FrontService::Ptr front() { return m_front; }
     bcos::crypto::KeyFactory::Ptr keyFactory() { return m_protocolInitializer->keyFactory(); }
 
+    // the block sync messages are counted by _syncRateStatistics, must be set before init
+    void setSyncRateStatistics(SyncRateStatistics::Ptr _syncRateStatistics)
+    {
+        m_syncRateStatistics = std::move(_syncRateStatistics);
+    }
+
+    // the messages of the module waiting for the dispatch
+    size_t dispatchQueueSize(bcos::protocol::ModuleID _moduleID) const;
+
 protected:
     virtual void initMsgHandlers(bcos::consensus::ConsensusInterface::Ptr _pbft,
         bcos::sync::BlockSyncInterface::Ptr _blockSync, bcos::txpool::TxPoolInterface::Ptr _txpool);
 
+    virtual void reportDispatchQueues();
+
 private:
     bcos::tool::NodeConfig::Ptr m_nodeConfig;
     bcos::initializer::ProtocolInitializer::Ptr m_protocolInitializer;
@@ -60,6 +76,18 @@ private:
 
     bcos::front::FrontService::Ptr m_front;
     std::atomic_bool m_running = {false};
+
+    // one thread keeps the PBFT messages of every peer in the order they arrive
+    static constexpr size_t c_pbftWorkerNum = 1;
+    // the front thread only copies the message and hands it to the pool of the module, so that the
+    // gossip of the txs can't delay the consensus messages
+    ModuleDispatcher::Ptr m_pbftDispatcher;
+    ModuleDispatcher::Ptr m_blockSyncDispatcher;
+    // the txs are gossiped by every peer, bound the pending messages of each peer
+    PeerMessageQueue::Ptr m_txsSyncQueue;
+    SyncRateStatistics::Ptr m_syncRateStatistics;
+    std::shared_ptr<bcos::Timer> m_reportTimer;
+    uint64_t m_reportInterval = 60000;
 };
 }  // namespace initializer
 }  // namespace bcos
\ No newline at end of file
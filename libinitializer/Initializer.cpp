@@ -27,6 +27,7 @@
 #include "Initializer.h"
 #include "ExecutorInitializer.h"
 #include "LedgerInitializer.h"
+#include "MemoryBudgetManager.h"
 #include "ParallelExecutor.h"
 #include "SchedulerInitializer.h"
 #include "StorageInitializer.h"
@@ -86,6 +87,20 @@ void Initializer::initConfig(std::string const& _configFilePath, std::string con
         // load the service config
         m_nodeConfig->loadServiceConfig(pt);
     }
+    m_storageConfig = StorageInitializer::loadConfig(pt);
+    m_memoryBudgetManager = MemoryBudgetManager::build(pt, m_storageConfig);
+    m_executorConfig = ParallelExecutorConfig::load(pt);
+    // the relative journal path is resolved in the same way as the storage path
+    std::string journalBasePath;
+    if (!_localMode)
+    {
+        journalBasePath = ServerConfig::BasePath + "../" + m_nodeConfig->groupId() + "/";
+    }
+    m_txpoolJournal = TxPoolJournal::build(pt, journalBasePath);
+    m_txBatchVerifier =
+        TxBatchVerifier::build(pt, m_protocolInitializer->blockFactory()->transactionFactory());
+    m_frontDispatchConfig = FrontDispatchConfig::load(pt);
+    m_pbftTuningConfig = PBFTTuningConfig::load(pt);
 }
 
 void Initializer::init(bcos::initializer::NodeArchitectureType _nodeArchType,
@@ -96,7 +111,7 @@ void Initializer::init(bcos::initializer::NodeArchitectureType _nodeArchType,
     {
         // build the front service
         m_frontServiceInitializer = std::make_shared<FrontServiceInitializer>(
-            m_nodeConfig, m_protocolInitializer, _gateway);
+            m_nodeConfig, m_protocolInitializer, _gateway, m_frontDispatchConfig);
 
         // build the storage
         auto storagePath = m_nodeConfig->storagePath();
@@ -106,7 +121,17 @@ void Initializer::init(bcos::initializer::NodeArchitectureType _nodeArchType,
                           m_nodeConfig->storagePath();
         }
         BCOS_LOG(INFO) << LOG_DESC("initNode") << LOG_KV("storagePath", storagePath);
-        auto storage = StorageInitializer::build(storagePath);
+        auto snapshotIdentity = std::make_shared<SnapshotIdentity>();
+        snapshotIdentity->chainId = m_nodeConfig->chainId();
+        snapshotIdentity->groupId = m_nodeConfig->groupId();
+        snapshotIdentity->checkBlocks = [blockFactory = m_protocolInitializer->blockFactory(),
+                                            nodeConfig = m_nodeConfig](
+                                            bcos::storage::StorageInterface::Ptr _snapshot) {
+            LedgerInitializer::checkGenesis(blockFactory, _snapshot, nodeConfig);
+        };
+        auto storage = StorageInitializer::build(storagePath, m_storageConfig,
+            m_memoryBudgetManager ? m_memoryBudgetManager->blockCache() : nullptr,
+            snapshotIdentity);
 
         // build ledger
         auto ledger =
@@ -127,31 +152,58 @@ void Initializer::init(bcos::initializer::NodeArchitectureType _nodeArchType,
         // init the txpool
         m_txpoolInitializer = std::make_shared<TxPoolInitializer>(
             m_nodeConfig, m_protocolInitializer, m_frontServiceInitializer->front(), ledger);
+        m_txpoolInitializer->setJournal(m_txpoolJournal);
+        m_txpoolInitializer->setBatchVerifier(m_txBatchVerifier);
 
         // build and init the pbft related modules
         m_pbftInitializer = std::make_shared<PBFTInitializer>(_nodeArchType, m_nodeConfig,
             m_protocolInitializer, m_txpoolInitializer->txpool(), ledger, m_scheduler, storage,
-            m_frontServiceInitializer->front());
+            m_frontServiceInitializer->front(), m_pbftTuningConfig);
 
         // init the txpool
-        m_txpoolInitializer->init(m_pbftInitializer->sealer());
+        std::weak_ptr<PBFTInitializer> weakPBFTInitializer = m_pbftInitializer;
+        m_txpoolInitializer->init([weakPBFTInitializer](size_t _unsealedTxsSize,
+                                      std::function<void(Error::Ptr)> _onRecv) {
+            auto pbftInitializer = weakPBFTInitializer.lock();
+            if (!pbftInitializer)
+            {
+                return;
+            }
+            pbftInitializer->asyncNoteUnSealedTxsSize(_unsealedTxsSize, _onRecv);
+        });
 
         // Note: must init PBFT after txpool, in case of pbft calls txpool to verifyBlock before
         // txpool init finished
         m_pbftInitializer->init();
 
         // init the frontService
+        m_frontServiceInitializer->setSyncRateStatistics(m_pbftInitializer->syncRateStatistics());
         m_frontServiceInitializer->init(m_pbftInitializer->pbft(), m_pbftInitializer->blockSync(),
             m_txpoolInitializer->txpool());
 
+        // the ExecutorManager dispatches every contract to one of the executors
+        // Note: the executors share one cache, the rows of the system tables and the other shared
+        // tables committed by one executor are seen by all the others, the state must not depend
+        // on how the contracts are dispatched
+        auto executorNum = m_executorConfig->executorNum;
+        auto executorShardConfig = m_executorConfig->executorShardConfig();
         auto cache = std::make_shared<bcos::executor::LRUStorage>(storage);
+        if (m_memoryBudgetManager)
+        {
+            m_memoryBudgetManager->registerExecutorCache(cache);
+        }
         cache->start();
-
-        auto executor = ExecutorInitializer::build(m_txpoolInitializer->txpool(), cache, storage,
-            executionMessageFactory, m_protocolInitializer->cryptoSuite()->hashImpl(),
-            m_nodeConfig->isWasm(), m_nodeConfig->isAuthCheck());
-        auto parallelExecutor = std::make_shared<bcos::initializer::ParallelExecutor>(executor);
-        executorManager->addExecutor("default", parallelExecutor);
+        for (size_t i = 0; i < executorNum; i++)
+        {
+            auto executor = ExecutorInitializer::build(m_txpoolInitializer->txpool(), cache,
+                storage, executionMessageFactory, m_protocolInitializer->cryptoSuite()->hashImpl(),
+                m_nodeConfig->isWasm(), m_nodeConfig->isAuthCheck());
+            auto parallelExecutor =
+                std::make_shared<bcos::initializer::ParallelExecutor>(executor, executorShardConfig);
+            auto executorName = (executorNum == 1) ? "default" : "executor" + std::to_string(i);
+            executorManager->addExecutor(executorName, parallelExecutor);
+            BCOS_LOG(INFO) << LOG_DESC("initNode: addExecutor") << LOG_KV("name", executorName);
+        }
 
         initSysContract();
     }
@@ -186,6 +238,10 @@ void Initializer::start()
 {
     try
     {
+        if (m_memoryBudgetManager)
+        {
+            m_memoryBudgetManager->start();
+        }
         if (m_txpoolInitializer)
         {
             m_txpoolInitializer->start();
@@ -223,6 +279,10 @@ void Initializer::stop()
         {
             m_txpoolInitializer->stop();
         }
+        if (m_memoryBudgetManager)
+        {
+            m_memoryBudgetManager->stop();
+        }
     }
     catch (std::exception const& e)
     {
@@ -21,7 +21,9 @@
 #pragma once
 #include "FrontServiceInitializer.h"
 #include "LedgerInitializer.h"
+#include "MemoryBudgetManager.h"
 #include "PBFTInitializer.h"
+#include "ParallelExecutor.h"
 #include "ProtocolInitializer.h"
 #include "SchedulerInitializer.h"
 #include "StorageInitializer.h"
@@ -76,9 +78,16 @@ protected:
 
 private:
     bcos::tool::NodeConfig::Ptr m_nodeConfig;
+    StorageConfig::Ptr m_storageConfig;
+    MemoryBudgetManager::Ptr m_memoryBudgetManager;
+    ParallelExecutorConfig::Ptr m_executorConfig;
     ProtocolInitializer::Ptr m_protocolInitializer;
     FrontServiceInitializer::Ptr m_frontServiceInitializer;
     TxPoolInitializer::Ptr m_txpoolInitializer;
+    TxPoolJournal::Ptr m_txpoolJournal;
+    TxBatchVerifier::Ptr m_txBatchVerifier;
+    FrontDispatchConfig::Ptr m_frontDispatchConfig;
+    PBFTTuningConfig::Ptr m_pbftTuningConfig;
 
     PBFTInitializer::Ptr m_pbftInitializer;
 
@@ -19,11 +19,13 @@
  * @date 2021-06-10
  */
 #pragma once
+#include "libinitializer/Common.h"
 #include <bcos-framework/interfaces/ledger/LedgerInterface.h>
 #include <bcos-framework/interfaces/protocol/BlockFactory.h>
 #include <bcos-framework/interfaces/storage/StorageInterface.h>
 #include <bcos-framework/libtool/NodeConfig.h>
 #include <bcos-ledger/libledger/Ledger.h>
+#include <future>
 
 namespace bcos::initializer
 {
@@ -40,5 +42,48 @@ public:
             _nodeConfig->ledgerConfig(), _nodeConfig->txGasLimit(), _nodeConfig->genesisData());
         return ledger;
     }
+
+    // throws if the genesis block of _storage is not built from the genesis config of the node
+    static void checkGenesis(bcos::protocol::BlockFactory::Ptr _blockFactory,
+        bcos::storage::StorageInterface::Ptr _storage, bcos::tool::NodeConfig::Ptr _nodeConfig)
+    {
+        auto ledger = std::make_shared<bcos::ledger::Ledger>(_blockFactory, _storage);
+        std::promise<std::pair<bcos::Error::Ptr, bcos::protocol::BlockNumber>> blockNumber;
+        ledger->asyncGetBlockNumber([&blockNumber](bcos::Error::Ptr _error,
+                                        bcos::protocol::BlockNumber _blockNumber) {
+            blockNumber.set_value(std::make_pair(_error, _blockNumber));
+        });
+        auto number = blockNumber.get_future().get();
+        if (number.first || number.second < 0)
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(-1, "LedgerInitializer: no block in the storage"));
+        }
+        std::promise<std::pair<bcos::Error::Ptr, bcos::protocol::Block::Ptr>> genesis;
+        ledger->asyncGetBlockDataByNumber(0, bcos::ledger::HEADER,
+            [&genesis](bcos::Error::Ptr _error, bcos::protocol::Block::Ptr _block) {
+                genesis.set_value(std::make_pair(_error, _block));
+            });
+        auto genesisBlock = genesis.get_future().get();
+        if (genesisBlock.first || !genesisBlock.second || !genesisBlock.second->blockHeader())
+        {
+            BOOST_THROW_EXCEPTION(
+                BCOS_ERROR(-1, "LedgerInitializer: no genesis block in the storage"));
+        }
+        auto header = genesisBlock.second->blockHeader();
+        // the genesis config is the extra data of the genesis block
+        auto extraData = header->extraData();
+        auto genesisData = _nodeConfig->genesisData();
+        if (std::string((char const*)extraData.data(), extraData.size()) != genesisData)
+        {
+            INITIALIZER_LOG(ERROR) << LOG_DESC("checkGenesis: the genesis block mismatch")
+                                   << LOG_KV("genesisHash", header->hash().abridged())
+                                   << LOG_KV("blockNumber", number.second);
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(
+                -1, "LedgerInitializer: the genesis block is not built from the genesis config"));
+        }
+        INITIALIZER_LOG(INFO) << LOG_DESC("checkGenesis success")
+                              << LOG_KV("genesisHash", header->hash().abridged())
+                              << LOG_KV("blockNumber", number.second);
+    }
 };
 }  // namespace bcos::initializer
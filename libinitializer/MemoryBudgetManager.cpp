@@ -0,0 +1,118 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the node-wide memory budget of the rocksDB block cache and the executor cache
+ * @file MemoryBudgetManager.cpp
+ * @date 2021-11-15
+ */
+#include "MemoryBudgetManager.h"
+
+using namespace bcos;
+using namespace bcos::initializer;
+
+MemoryBudgetManager::MemoryBudgetManager(
+    StorageConfig::Ptr _storageConfig, size_t _memoryBudget, double _executorCacheRatio)
+  : m_memoryBudget(_memoryBudget)
+{
+    // the memtables are sized by the storage profile, the caches share the rest
+    m_memtableSize = _storageConfig->writeBufferSize * (size_t)_storageConfig->maxWriteBufferNumber;
+    if (m_memoryBudget <= m_memtableSize)
+    {
+        BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                  "storage.memory_budget must be larger than the memtables: " +
+                                  std::to_string(m_memtableSize / 1024 / 1024) + "MB"));
+    }
+    auto cacheSize = m_memoryBudget - m_memtableSize;
+    m_executorCacheCapacity = (size_t)(cacheSize * _executorCacheRatio);
+    m_blockCacheCapacity = cacheSize - m_executorCacheCapacity;
+    // the block cache is created here so that its usage can be reported, it's passed to the
+    // storage builder in place of the block cache sized by the StorageConfig
+    m_blockCache = rocksdb::NewLRUCache(m_blockCacheCapacity);
+
+    m_timer = std::make_shared<Timer>(m_reportInterval, "memory budget report");
+    m_timer->registerTimeoutHandler(boost::bind(&MemoryBudgetManager::reportMetrics, this));
+    INITIALIZER_LOG(INFO) << LOG_DESC("MemoryBudgetManager") << LOG_KV("budget", m_memoryBudget)
+                          << LOG_KV("memtables", m_memtableSize)
+                          << LOG_KV("blockCache", m_blockCacheCapacity)
+                          << LOG_KV("executorCache", m_executorCacheCapacity);
+}
+
+MemoryBudgetManager::Ptr MemoryBudgetManager::build(
+    boost::property_tree::ptree const& _pt, StorageConfig::Ptr _storageConfig)
+{
+    // in MB, 0 means the caches are sized by the storage profile and the executor defaults
+    auto memoryBudget = _pt.get<size_t>("storage.memory_budget", 0);
+    if (memoryBudget == 0)
+    {
+        return nullptr;
+    }
+    auto executorCacheRatio = _pt.get<double>("storage.executor_cache_ratio", 0.3);
+    if (executorCacheRatio <= 0 || executorCacheRatio >= 1)
+    {
+        BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                  "storage.executor_cache_ratio must be in (0, 1)"));
+    }
+    return std::make_shared<MemoryBudgetManager>(
+        _storageConfig, memoryBudget * 1024 * 1024, executorCacheRatio);
+}
+
+void MemoryBudgetManager::start()
+{
+    if (m_timer)
+    {
+        m_timer->start();
+    }
+}
+
+void MemoryBudgetManager::stop()
+{
+    if (m_timer)
+    {
+        m_timer->stop();
+    }
+}
+
+void MemoryBudgetManager::registerExecutorCache(
+    std::shared_ptr<bcos::executor::LRUStorage> _cache)
+{
+    std::lock_guard<std::mutex> l(m_mutex);
+    m_executorCaches.emplace_back(_cache);
+    auto capacity = m_executorCacheCapacity / m_executorCaches.size();
+    for (auto const& cache : m_executorCaches)
+    {
+        cache->setMaxCapacity(capacity);
+    }
+    INITIALIZER_LOG(INFO) << LOG_DESC("registerExecutorCache")
+                          << LOG_KV("executorCaches", m_executorCaches.size())
+                          << LOG_KV("capacityPerCache", capacity);
+}
+
+void MemoryBudgetManager::reportMetrics()
+{
+    size_t executorCaches = 0;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        executorCaches = m_executorCaches.size();
+    }
+    INITIALIZER_LOG(INFO) << LOG_BADGE("METRIC") << LOG_DESC("MemoryBudgetManager")
+                          << LOG_KV("budget", m_memoryBudget)
+                          << LOG_KV("memtables", m_memtableSize)
+                          << LOG_KV("blockCacheCapacity", m_blockCacheCapacity)
+                          << LOG_KV("blockCacheUsage", m_blockCache->GetUsage())
+                          << LOG_KV("blockCachePinnedUsage", m_blockCache->GetPinnedUsage())
+                          << LOG_KV("executorCacheCapacity", m_executorCacheCapacity)
+                          << LOG_KV("executorCaches", executorCaches);
+    m_timer->restart();
+}
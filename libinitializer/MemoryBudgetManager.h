@@ -0,0 +1,72 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the node-wide memory budget of the rocksDB block cache and the executor cache
+ * @file MemoryBudgetManager.h
+ * @date 2021-11-15
+ */
+#pragma once
+#include "libinitializer/StorageInitializer.h"
+#include <bcos-executor/LRUStorage.h>
+#include <bcos-framework/libutilities/Timer.h>
+#include <rocksdb/cache.h>
+#include <mutex>
+
+namespace bcos::initializer
+{
+class MemoryBudgetManager
+{
+public:
+    using Ptr = std::shared_ptr<MemoryBudgetManager>;
+    // _memoryBudget: the memory shared by the rocksDB memtables, the rocksDB block cache and the
+    // executor caches
+    // _executorCacheRatio: the ratio of the executor caches after the memtables are subtracted
+    // Note: _storageConfig is only read, the block cache size of the budget is carried by
+    // blockCache()
+    MemoryBudgetManager(
+        StorageConfig::Ptr _storageConfig, size_t _memoryBudget, double _executorCacheRatio);
+    virtual ~MemoryBudgetManager() { stop(); }
+
+    // load the [storage] memory_budget, return nullptr when no budget is configured
+    static MemoryBudgetManager::Ptr build(
+        boost::property_tree::ptree const& _pt, StorageConfig::Ptr _storageConfig);
+
+    virtual void start();
+    virtual void stop();
+
+    std::shared_ptr<rocksdb::Cache> blockCache() { return m_blockCache; }
+    size_t blockCacheCapacity() const { return m_blockCacheCapacity; }
+    size_t executorCacheCapacity() const { return m_executorCacheCapacity; }
+
+    // the budget of the executor caches is shared by all the registered caches
+    virtual void registerExecutorCache(std::shared_ptr<bcos::executor::LRUStorage> _cache);
+
+protected:
+    virtual void reportMetrics();
+
+private:
+    size_t m_memoryBudget;
+    size_t m_memtableSize;
+    size_t m_blockCacheCapacity;
+    size_t m_executorCacheCapacity;
+    std::shared_ptr<rocksdb::Cache> m_blockCache;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::shared_ptr<bcos::executor::LRUStorage>> m_executorCaches;
+
+    std::shared_ptr<bcos::Timer> m_timer;
+    uint64_t m_reportInterval = 60000;
+};
+}  // namespace bcos::initializer
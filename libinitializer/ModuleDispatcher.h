@@ -0,0 +1,113 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the dispatch pool of the inbound messages of one module
+ * @file ModuleDispatcher.h
+ * @date 2021-11-23
+ */
+#pragma once
+#include "libinitializer/Common.h"
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+
+namespace bcos::initializer
+{
+// the dispatch pools of the front service, the modules are listed in the priority order
+// Note: the PBFT messages are always dispatched by one thread, the PBFT engine expects the
+// messages of a peer in the order they are sent
+struct FrontDispatchConfig
+{
+    using Ptr = std::shared_ptr<FrontDispatchConfig>;
+    size_t blockSyncWorkerNum = 1;
+    size_t txsSyncWorkerNum = 1;
+    // the txsSync messages of one peer waiting for the dispatch, the oldest are dropped beyond
+    size_t txsSyncPeerQueueSize = 1000;
+
+    static FrontDispatchConfig::Ptr load(boost::property_tree::ptree const& _pt)
+    {
+        auto config = std::make_shared<FrontDispatchConfig>();
+        if (_pt.get<size_t>("front.pbft_worker_num", 1) != 1)
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "front.pbft_worker_num must be 1, the PBFT messages are "
+                                      "dispatched in order by one thread"));
+        }
+        config->blockSyncWorkerNum =
+            _pt.get<size_t>("front.block_sync_worker_num", config->blockSyncWorkerNum);
+        config->txsSyncWorkerNum =
+            _pt.get<size_t>("front.txs_sync_worker_num", config->txsSyncWorkerNum);
+        config->txsSyncPeerQueueSize =
+            _pt.get<size_t>("front.txs_sync_peer_queue_size", config->txsSyncPeerQueueSize);
+        if (config->blockSyncWorkerNum == 0 || config->txsSyncWorkerNum == 0)
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "front.block_sync_worker_num and front.txs_sync_worker_num "
+                                      "must be positive"));
+        }
+        if (config->txsSyncPeerQueueSize == 0)
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "front.txs_sync_peer_queue_size must be positive"));
+        }
+        INITIALIZER_LOG(INFO) << LOG_DESC("loadFrontDispatchConfig")
+                              << LOG_KV("blockSyncWorkerNum", config->blockSyncWorkerNum)
+                              << LOG_KV("txsSyncWorkerNum", config->txsSyncWorkerNum)
+                              << LOG_KV("txsSyncPeerQueueSize", config->txsSyncPeerQueueSize);
+        return config;
+    }
+};
+
+class ModuleDispatcher
+{
+public:
+    using Ptr = std::shared_ptr<ModuleDispatcher>;
+    // _niceValue: the lower priority modules run with a larger nice value
+    ModuleDispatcher(std::string const& _name, size_t _workerNum, int _niceValue)
+      : m_name(_name), m_niceValue(_niceValue), m_pool(_name, _workerNum)
+    {}
+
+    // Note: the message data must be owned by the task, the bytesConstRef passed to the
+    // dispatcher of the front service is released once the dispatcher returns
+    template <class F>
+    void enqueue(F _task)
+    {
+        ++m_pendingTasks;
+        m_pool.enqueue([this, task = std::move(_task)]() mutable {
+            --m_pendingTasks;
+            thread_local bool niced = false;
+            if (!niced && m_niceValue != 0)
+            {
+                niced = true;
+                setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), m_niceValue);
+            }
+            task();
+        });
+    }
+
+    std::string const& name() const { return m_name; }
+    // the messages waiting for the dispatch
+    size_t pendingTasks() const { return m_pendingTasks; }
+
+private:
+    std::string m_name;
+    int m_niceValue;
+    std::atomic<size_t> m_pendingTasks = {0};
+    // destroyed first, the running tasks are joined before the other members are released
+    bcos::ThreadPool m_pool;
+};
+}  // namespace bcos::initializer
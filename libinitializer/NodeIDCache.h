@@ -0,0 +1,125 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the KeyFactory that interns the nodeIDs of the inbound messages
+ * @file NodeIDCache.h
+ * @date 2021-11-22
+ */
+#pragma once
+#include <bcos-framework/interfaces/crypto/KeyFactory.h>
+#include <bcos-framework/libutilities/FixedBytes.h>
+#include <bcos-framework/libutilities/Log.h>
+#include <atomic>
+#include <cstring>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace bcos::initializer
+{
+// the nodeIDs of the peers are rebuilt from the raw bytes of every inbound message, the cache
+// returns the same PublicPtr for the same bytes instead
+// Note: only the 64 bytes public keys are cached, the private keys and the other keys are created
+// by the underlying KeyFactory every time
+class NodeIDCache : public bcos::crypto::KeyFactory
+{
+public:
+    using Ptr = std::shared_ptr<NodeIDCache>;
+    NodeIDCache(bcos::crypto::KeyFactory::Ptr _keyFactory, size_t _capacity = 10000)
+      : m_keyFactory(std::move(_keyFactory)), m_capacity(_capacity)
+    {}
+    ~NodeIDCache() override {}
+
+    bcos::crypto::KeyInterface::Ptr createKey(bcos::bytesConstRef _keyData) override
+    {
+        if (_keyData.size() != bcos::h512::size)
+        {
+            return m_keyFactory->createKey(_keyData);
+        }
+        bcos::h512 rawNodeID(_keyData.data(), _keyData.size());
+        bcos::crypto::KeyInterface::Ptr cachedNodeID;
+        {
+            std::shared_lock<std::shared_mutex> l(m_mutex);
+            auto it = m_nodeIDs.find(rawNodeID);
+            if (it != m_nodeIDs.end())
+            {
+                cachedNodeID = it->second;
+            }
+        }
+        onLookup(cachedNodeID != nullptr);
+        if (cachedNodeID)
+        {
+            return cachedNodeID;
+        }
+        auto nodeID = m_keyFactory->createKey(_keyData);
+        std::unique_lock<std::shared_mutex> l(m_mutex);
+        // the unknown nodeIDs beyond the capacity are not cached
+        if (m_nodeIDs.size() < m_capacity)
+        {
+            return m_nodeIDs.emplace(rawNodeID, nodeID).first->second;
+        }
+        return nodeID;
+    }
+
+    bcos::crypto::KeyInterface::Ptr createKey(bcos::bytes const& _keyData) override
+    {
+        return createKey(bcos::ref(_keyData));
+    }
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    size_t size() const
+    {
+        std::shared_lock<std::shared_mutex> l(m_mutex);
+        return m_nodeIDs.size();
+    }
+
+private:
+    void onLookup(bool _hit)
+    {
+        auto hits = _hit ? ++m_hits : m_hits.load();
+        auto misses = _hit ? m_misses.load() : ++m_misses;
+        if ((hits + misses) % c_reportInterval != 0)
+        {
+            return;
+        }
+        BCOS_LOG(INFO) << LOG_BADGE("METRIC") << LOG_DESC("NodeIDCache") << LOG_KV("hits", hits)
+                       << LOG_KV("misses", misses)
+                       << LOG_KV("hitRate", (double)hits / (double)(hits + misses))
+                       << LOG_KV("cachedNodeIDs", size());
+    }
+
+    // the public keys are uniformly distributed, the leading bytes are a good enough hash
+    struct NodeIDHasher
+    {
+        size_t operator()(bcos::h512 const& _nodeID) const
+        {
+            size_t hash;
+            std::memcpy(&hash, _nodeID.data(), sizeof(hash));
+            return hash;
+        }
+    };
+
+private:
+    bcos::crypto::KeyFactory::Ptr m_keyFactory;
+    size_t m_capacity;
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<bcos::h512, bcos::crypto::KeyInterface::Ptr, NodeIDHasher> m_nodeIDs;
+
+    std::atomic<uint64_t> m_hits = {0};
+    std::atomic<uint64_t> m_misses = {0};
+    static constexpr uint64_t c_reportInterval = 100000;
+};
+}  // namespace bcos::initializer
@@ -44,15 +44,24 @@ PBFTInitializer::PBFTInitializer(bcos::initializer::NodeArchitectureType _nodeAr
     bcos::txpool::TxPoolInterface::Ptr _txpool, std::shared_ptr<bcos::ledger::Ledger> _ledger,
     bcos::scheduler::SchedulerInterface::Ptr _scheduler,
     bcos::storage::StorageInterface::Ptr _storage,
-    std::shared_ptr<bcos::front::FrontServiceInterface> _frontService)
+    std::shared_ptr<bcos::front::FrontServiceInterface> _frontService,
+    PBFTTuningConfig::Ptr _tuningConfig)
   : m_nodeConfig(_nodeConfig),
     m_protocolInitializer(_protocolInitializer),
     m_txpool(_txpool),
     m_ledger(_ledger),
     m_scheduler(_scheduler),
     m_storage(_storage),
-    m_frontService(_frontService)
+    m_frontService(_frontService),
+    m_tuningConfig(_tuningConfig),
+    m_phaseStatistics(std::make_shared<ConsensusPhaseStatistics>()),
+    m_syncRateStatistics(std::make_shared<SyncRateStatistics>())
 {
+    if (m_tuningConfig->adaptiveSeal)
+    {
+        m_sealPolicy =
+            std::make_shared<AdaptiveSealPolicy>(m_phaseStatistics, m_nodeConfig->minSealTime());
+    }
     createSealer();
     createPBFT();
     createSync();
@@ -114,7 +123,8 @@ void PBFTInitializer::initChainNodeInfo(
     bcos::initializer::NodeArchitectureType _nodeArchType, bcos::tool::NodeConfig::Ptr _nodeConfig)
 {
     m_groupInfo = std::make_shared<GroupInfo>(_nodeConfig->chainId(), _nodeConfig->groupId());
-    m_groupInfo->setGenesisConfig(generateGenesisConfig(_nodeConfig));
+    auto genesisConfig = generateGenesisConfig(_nodeConfig);
+    m_groupInfo->setGenesisConfig(genesisConfig);
     int32_t nodeType = bcos::group::NodeType::NON_SM_NODE;
     if (_nodeConfig->smCryptoType())
     {
@@ -128,7 +138,8 @@ void PBFTInitializer::initChainNodeInfo(
     auto chainNodeInfo = std::make_shared<ChainNodeInfo>(_nodeConfig->nodeName(), nodeType);
     chainNodeInfo->setNodeID(m_protocolInitializer->keyPair()->publicKey()->hex());
 
-    chainNodeInfo->setIniConfig(generateIniConfig(_nodeConfig));
+    auto iniConfig = generateIniConfig(_nodeConfig);
+    chainNodeInfo->setIniConfig(iniConfig);
     chainNodeInfo->setMicroService(microServiceMode);
 
     bool useConfigServiceName = false;
@@ -147,14 +158,40 @@ void PBFTInitializer::initChainNodeInfo(
     chainNodeInfo->appendServiceInfo(
         TXPOOL, useConfigServiceName ? m_nodeConfig->txpoolServiceName() : localNodeServiceName);
     m_groupInfo->appendNodeInfo(chainNodeInfo);
+    // the service names are derived from the ini config and the architecture type
+    auto nodeID = m_protocolInitializer->keyPair()->publicKey()->hex();
+    // Note: the hash of the crypto suite is stable across the builds and the restarts,
+    // std::hash is not
+    auto content = genesisConfig + iniConfig + nodeID + std::to_string(nodeType) +
+                   std::to_string(_nodeArchType);
+    m_groupInfoHash = m_protocolInitializer->cryptoSuite()->hashImpl()->hash(
+        bcos::bytesConstRef((const bcos::byte*)content.data(), content.size()));
 }
 
 void PBFTInitializer::reportNodeInfo()
 {
-    asyncNotifyGroupInfo<bcostars::RpcServicePrx, bcostars::RpcServiceClient>(
-        m_nodeConfig->rpcServiceName(), m_groupInfo);
-    asyncNotifyGroupInfo<bcostars::GatewayServicePrx, bcostars::GatewayServiceClient>(
-        m_nodeConfig->gatewayServiceName(), m_groupInfo);
+    try
+    {
+        // the reporters are created on the first report, only the started reports need them
+        if (!m_rpcReporter)
+        {
+            m_rpcReporter = std::make_shared<
+                GroupInfoReporter<bcostars::RpcServicePrx, bcostars::RpcServiceClient>>(
+                m_nodeConfig->rpcServiceName());
+            m_gatewayReporter = std::make_shared<
+                GroupInfoReporter<bcostars::GatewayServicePrx, bcostars::GatewayServiceClient>>(
+                m_nodeConfig->gatewayServiceName());
+        }
+        auto heartbeat = (m_reportTicks++ % c_heartbeatTicks == 0);
+        m_rpcReporter->report(m_groupInfo, m_groupInfoHash, heartbeat);
+        m_gatewayReporter->report(m_groupInfo, m_groupInfoHash, heartbeat);
+    }
+    catch (std::exception const& e)
+    {
+        // keep the timer running, the next tick reports again
+        INITIALIZER_LOG(WARNING) << LOG_DESC("reportNodeInfo exception")
+                                 << LOG_KV("error", boost::diagnostic_information(e));
+    }
     m_timer->restart();
 }
 
@@ -191,6 +228,31 @@ void PBFTInitializer::init()
     m_pbft->init();
 }
 
+void PBFTInitializer::asyncNoteUnSealedTxsSize(
+    size_t _unsealedTxsSize, std::function<void(bcos::Error::Ptr)> _onRecvResponse)
+{
+    if (m_sealPolicy)
+    {
+        m_sealPolicy->onUnsealedTxsSize(_unsealedTxsSize);
+    }
+    m_sealer->asyncNoteUnSealedTxsSize(_unsealedTxsSize, _onRecvResponse);
+}
+
+void PBFTInitializer::asyncGetSyncInfo(
+    std::function<void(bcos::Error::Ptr, std::string const&)> _onGetSyncInfo)
+{
+    auto syncRateStatistics = m_syncRateStatistics;
+    m_blockSync->asyncGetSyncInfo([syncRateStatistics, _onGetSyncInfo](
+                                      bcos::Error::Ptr _error, std::string const& _syncInfo) {
+        if (_error)
+        {
+            _onGetSyncInfo(_error, _syncInfo);
+            return;
+        }
+        _onGetSyncInfo(nullptr, syncRateStatistics->appendTo(_syncInfo));
+    });
+}
+
 void PBFTInitializer::registerHandlers()
 {
     // handler to notify the sealer reset the sealing proposals
@@ -214,9 +276,13 @@ void PBFTInitializer::registerHandlers()
     });
 
     // register handlers for the consensus to interact with the sealer
+    auto phaseStatistics = m_phaseStatistics;
+    auto sealPolicy = m_sealPolicy;
     m_pbft->registerSealProposalNotifier(
-        [weakedSealer](size_t _proposalIndex, size_t _proposalEndIndex, size_t _maxTxsToSeal,
+        [weakedSealer, phaseStatistics, sealPolicy](size_t _proposalIndex,
+            size_t _proposalEndIndex, size_t _maxTxsToSeal,
             std::function<void(Error::Ptr)> _onRecvResponse) {
+            phaseStatistics->onSealNotified(_proposalIndex, _proposalEndIndex);
             try
             {
                 auto sealer = weakedSealer.lock();
@@ -224,8 +290,18 @@ void PBFTInitializer::registerHandlers()
                 {
                     return;
                 }
+                auto maxTxsToSeal = _maxTxsToSeal;
+                if (sealPolicy)
+                {
+                    maxTxsToSeal = sealPolicy->maxTxsToSeal(_maxTxsToSeal);
+                    INITIALIZER_LOG(DEBUG) << LOG_DESC("adaptive seal")
+                                           << LOG_KV("startIndex", _proposalIndex)
+                                           << LOG_KV("endIndex", _proposalEndIndex)
+                                           << LOG_KV("blockTxCountLimit", _maxTxsToSeal)
+                                           << LOG_KV("maxTxsToSeal", maxTxsToSeal);
+                }
                 sealer->asyncNotifySealProposal(
-                    _proposalIndex, _proposalEndIndex, _maxTxsToSeal, _onRecvResponse);
+                    _proposalIndex, _proposalEndIndex, maxTxsToSeal, _onRecvResponse);
             }
             catch (std::exception const& e)
             {
@@ -235,7 +311,10 @@ void PBFTInitializer::registerHandlers()
         });
 
     // the consensus module notify the latest blockNumber to the sealer
-    m_pbft->registerStateNotifier([weakedSealer](bcos::protocol::BlockNumber _blockNumber) {
+    auto syncRateStatistics = m_syncRateStatistics;
+    m_pbft->registerStateNotifier([weakedSealer, syncRateStatistics](
+                                      bcos::protocol::BlockNumber _blockNumber) {
+        syncRateStatistics->onBlockNumber(_blockNumber);
         try
         {
             auto sealer = weakedSealer.lock();
@@ -255,8 +334,10 @@ void PBFTInitializer::registerHandlers()
 
     // the consensus moudle notify new block to the sync module
     std::weak_ptr<BlockSyncInterface> weakedSync = m_blockSync;
-    m_pbft->registerNewBlockNotifier([weakedSync](bcos::ledger::LedgerConfig::Ptr _ledgerConfig,
+    m_pbft->registerNewBlockNotifier([weakedSync, phaseStatistics](
+                                         bcos::ledger::LedgerConfig::Ptr _ledgerConfig,
                                          std::function<void(Error::Ptr)> _onRecv) {
+        phaseStatistics->onStored(_ledgerConfig->blockNumber());
         try
         {
             auto sync = weakedSync.lock();
@@ -275,8 +356,9 @@ void PBFTInitializer::registerHandlers()
     });
 
     m_pbft->registerCommittedProposalNotifier(
-        [weakedSync](bcos::protocol::BlockNumber _committedProposal,
+        [weakedSync, phaseStatistics](bcos::protocol::BlockNumber _committedProposal,
             std::function<void(Error::Ptr)> _onRecv) {
+            phaseStatistics->onCommitted(_committedProposal);
             try
             {
                 auto sync = weakedSync.lock();
@@ -316,6 +398,14 @@ void PBFTInitializer::createPBFT()
     m_pbft = pbftFactory->createPBFT();
     auto pbftConfig = m_pbft->pbftEngine()->pbftConfig();
     pbftConfig->setCheckPointTimeoutInterval(m_nodeConfig->checkPointTimeoutInterval());
+    // the sealer, the consensus phases and the execution of the heights within the water mark
+    // limit overlap, a deeper pipeline hides more round trips of a high latency network
+    if (m_tuningConfig->pipelineDepth > 0)
+    {
+        pbftConfig->setWaterMarkLimit(m_tuningConfig->pipelineDepth);
+        INITIALIZER_LOG(INFO) << LOG_DESC("createPBFT: set the pipeline depth")
+                              << LOG_KV("waterMarkLimit", m_tuningConfig->pipelineDepth);
+    }
 }
 
 void PBFTInitializer::createSync()
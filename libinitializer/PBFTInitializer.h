@@ -20,6 +20,9 @@
  */
 #pragma once
 #include "Common/TarsUtils.h"
+#include "libinitializer/AdaptiveSealPolicy.h"
+#include "libinitializer/ConsensusPhaseStatistics.h"
+#include "libinitializer/SyncRateStatistics.h"
 #include "libinitializer/ProtocolInitializer.h"
 #include <bcos-framework/interfaces/front/FrontServiceInterface.h>
 #include <bcos-framework/interfaces/gateway/GatewayInterface.h>
@@ -30,6 +33,7 @@
 #include <bcos-ledger/libledger/Ledger.h>
 #include <bcos-pbft/pbft/PBFTFactory.h>
 #include <bcos-sync/BlockSyncFactory.h>
+#include <bcos-tars-protocol/client/GatewayServiceClient.h>
 #include <bcos-tars-protocol/client/RpcServiceClient.h>
 #include <bcos-txpool/TxPoolFactory.h>
 
@@ -37,6 +41,128 @@ namespace bcos
 {
 namespace initializer
 {
+// the [consensus] options applied to the PBFT engine created by the initializer
+struct PBFTTuningConfig
+{
+    using Ptr = std::shared_ptr<PBFTTuningConfig>;
+    // the proposals above the committed height being sealed and agreed on concurrently, 0 keeps the
+    // water mark limit of the PBFT engine
+    size_t pipelineDepth = 0;
+    // size the proposals from the unsealed transactions and the recent heights, false seals by
+    // min_seal_time and block_tx_count_limit only
+    bool adaptiveSeal = false;
+
+    static PBFTTuningConfig::Ptr load(boost::property_tree::ptree const& _pt)
+    {
+        auto config = std::make_shared<PBFTTuningConfig>();
+        config->pipelineDepth = _pt.get<size_t>("consensus.pipeline_depth", 0);
+        config->adaptiveSeal = _pt.get<bool>("consensus.adaptive_seal", false);
+        INITIALIZER_LOG(INFO) << LOG_DESC("loadPBFTTuningConfig")
+                              << LOG_KV("pipelineDepth", config->pipelineDepth)
+                              << LOG_KV("adaptiveSeal", config->adaptiveSeal);
+        return config;
+    }
+};
+
+// report the group info to every endpoint of a service, the endpoints that have received the
+// same content are skipped until the heartbeat
+template <class Prx, class Client>
+class GroupInfoReporter : public std::enable_shared_from_this<GroupInfoReporter<Prx, Client>>
+{
+public:
+    using Ptr = std::shared_ptr<GroupInfoReporter<Prx, Client>>;
+    explicit GroupInfoReporter(std::string const& _serviceName)
+      : m_clients(std::make_shared<bcostars::EndpointClientCache<Prx, Client>>(_serviceName))
+    {}
+
+    // _contentHash: changes whenever the content of _groupInfo changes
+    void report(bcos::group::GroupInfo::Ptr _groupInfo, bcos::crypto::HashType const& _contentHash,
+        bool _heartbeat)
+    {
+        decltype(m_clients->clients()) clients;
+        try
+        {
+            clients = m_clients->clients();
+        }
+        catch (std::exception const& e)
+        {
+            BCOS_LOG(WARNING) << LOG_DESC("asyncNotifyGroupInfo: get clients failed")
+                              << LOG_KV("error", boost::diagnostic_information(e));
+            return;
+        }
+        if (clients.empty())
+        {
+            BCOS_LOG(TRACE) << LOG_DESC("asyncNotifyGroupInfo error for empty connection")
+                            << bcos::group::printGroupInfo(_groupInfo);
+            return;
+        }
+        std::vector<std::pair<std::string, std::shared_ptr<Client>>> outdatedClients;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            std::map<std::string, bcos::crypto::HashType> reportedHashes;
+            for (auto const& it : clients)
+            {
+                auto reported = m_reportedHashes.find(it.first);
+                if (reported != m_reportedHashes.end())
+                {
+                    // the endpoints left the service are forgotten
+                    reportedHashes.emplace(it.first, reported->second);
+                }
+                if (_heartbeat || reported == m_reportedHashes.end() ||
+                    reported->second != _contentHash)
+                {
+                    outdatedClients.emplace_back(it);
+                }
+            }
+            m_reportedHashes = std::move(reportedHashes);
+        }
+        std::weak_ptr<GroupInfoReporter<Prx, Client>> weakReporter = this->shared_from_this();
+        for (auto const& it : outdatedClients)
+        {
+            try
+            {
+                it.second->asyncNotifyGroupInfo(_groupInfo,
+                    [weakReporter, endPoint = it.first, _groupInfo, _contentHash](
+                        Error::Ptr&& _error) {
+                        auto reporter = weakReporter.lock();
+                        if (!reporter)
+                        {
+                            return;
+                        }
+                        if (_error)
+                        {
+                            BCOS_LOG(ERROR) << LOG_DESC("asyncNotifyGroupInfo error")
+                                            << LOG_KV("endPoint", endPoint)
+                                            << LOG_KV("code", _error->errorCode())
+                                            << LOG_KV("msg", _error->errorMessage());
+                            // forget the content received by the endpoint, the next tick of
+                            // report finds no reported hash and notifies it again
+                            std::lock_guard<std::mutex> l(reporter->m_mutex);
+                            reporter->m_reportedHashes.erase(endPoint);
+                            return;
+                        }
+                        std::lock_guard<std::mutex> l(reporter->m_mutex);
+                        reporter->m_reportedHashes[endPoint] = _contentHash;
+                    });
+            }
+            catch (std::exception const& e)
+            {
+                BCOS_LOG(WARNING) << LOG_DESC("asyncNotifyGroupInfo exception")
+                                  << LOG_KV("endPoint", it.first)
+                                  << LOG_KV("error", boost::diagnostic_information(e));
+                std::lock_guard<std::mutex> l(m_mutex);
+                m_reportedHashes.erase(it.first);
+            }
+        }
+    }
+
+private:
+    typename bcostars::EndpointClientCache<Prx, Client>::Ptr m_clients;
+    std::mutex m_mutex;
+    // endpoint => the content hash of the group info received by the endpoint
+    std::map<std::string, bcos::crypto::HashType> m_reportedHashes;
+};
+
 class PBFTInitializer
 {
 public:
@@ -46,7 +172,8 @@ public:
         bcos::txpool::TxPoolInterface::Ptr _txpool, std::shared_ptr<bcos::ledger::Ledger> _ledger,
         bcos::scheduler::SchedulerInterface::Ptr _scheduler,
         bcos::storage::StorageInterface::Ptr _storage,
-        std::shared_ptr<bcos::front::FrontServiceInterface> _frontService);
+        std::shared_ptr<bcos::front::FrontServiceInterface> _frontService,
+        PBFTTuningConfig::Ptr _tuningConfig = std::make_shared<PBFTTuningConfig>());
 
     virtual ~PBFTInitializer() { stop(); }
 
@@ -59,8 +186,15 @@ public:
 
     bcos::txpool::TxPoolInterface::Ptr txpool() { return m_txpool; }
     bcos::sync::BlockSync::Ptr blockSync() { return m_blockSync; }
+    SyncRateStatistics::Ptr syncRateStatistics() { return m_syncRateStatistics; }
+    // the sync info of the block sync with the download and commit rates
+    virtual void asyncGetSyncInfo(
+        std::function<void(bcos::Error::Ptr, std::string const&)> _onGetSyncInfo);
     bcos::consensus::PBFTImpl::Ptr pbft() { return m_pbft; }
     bcos::sealer::Sealer::Ptr sealer() { return m_sealer; }
+    // the txpool notifies the unsealed transactions size to the sealer through the initializer
+    virtual void asyncNoteUnSealedTxsSize(
+        size_t _unsealedTxsSize, std::function<void(bcos::Error::Ptr)> _onRecvResponse);
 
     bcos::protocol::BlockFactory::Ptr blockFactory()
     {
@@ -80,40 +214,6 @@ protected:
 
     virtual void reportNodeInfo();
 
-    template <typename T, typename S>
-    void asyncNotifyGroupInfo(
-        std::string const& _serviceName, bcos::group::GroupInfo::Ptr _groupInfo)
-    {
-        auto servicePrx = Application::getCommunicator()->stringToProxy<T>(_serviceName);
-        vector<EndpointInfo> activeEndPoints;
-        vector<EndpointInfo> nactiveEndPoints;
-        servicePrx->tars_endpointsAll(activeEndPoints, nactiveEndPoints);
-        if (activeEndPoints.size() == 0)
-        {
-            BCOS_LOG(TRACE) << LOG_DESC("asyncNotifyGroupInfo error for empty connection")
-                            << bcos::group::printGroupInfo(_groupInfo);
-            return;
-        }
-        for (auto const& endPoint : activeEndPoints)
-        {
-            auto endPointStr = bcostars::endPointToString(_serviceName, endPoint.getEndpoint());
-            auto servicePrx = Application::getCommunicator()->stringToProxy<T>(endPointStr);
-            auto serviceClient = std::make_shared<S>(servicePrx);
-            serviceClient->asyncNotifyGroupInfo(
-                _groupInfo, [endPointStr, _groupInfo](Error::Ptr&& _error) {
-                    // TODO: retry when notify failed
-                    if (_error)
-                    {
-                        BCOS_LOG(ERROR) << LOG_DESC("asyncNotifyGroupInfo error")
-                                        << LOG_KV("endPoint", endPointStr)
-                                        << LOG_KV("code", _error->errorCode())
-                                        << LOG_KV("msg", _error->errorMessage());
-                        return;
-                    }
-                });
-        }
-    }
-
     std::string generateGenesisConfig(bcos::tool::NodeConfig::Ptr _nodeConfig);
     std::string generateIniConfig(bcos::tool::NodeConfig::Ptr _nodeConfig);
 
@@ -127,6 +227,11 @@ private:
     bcos::scheduler::SchedulerInterface::Ptr m_scheduler;
     bcos::storage::StorageInterface::Ptr m_storage;
     std::shared_ptr<bcos::front::FrontServiceInterface> m_frontService;
+    PBFTTuningConfig::Ptr m_tuningConfig;
+    ConsensusPhaseStatistics::Ptr m_phaseStatistics;
+    // nullptr when the adaptive seal is disabled
+    AdaptiveSealPolicy::Ptr m_sealPolicy;
+    SyncRateStatistics::Ptr m_syncRateStatistics;
 
     bcos::sealer::Sealer::Ptr m_sealer;
     bcos::sync::BlockSync::Ptr m_blockSync;
@@ -136,6 +241,15 @@ private:
     uint64_t m_timerSchedulerInterval = 3000;
 
     bcos::group::GroupInfo::Ptr m_groupInfo;
+    // the hash of the content of m_groupInfo
+    bcos::crypto::HashType m_groupInfoHash;
+    GroupInfoReporter<bcostars::RpcServicePrx, bcostars::RpcServiceClient>::Ptr m_rpcReporter;
+    GroupInfoReporter<bcostars::GatewayServicePrx, bcostars::GatewayServiceClient>::Ptr
+        m_gatewayReporter;
+    // the unchanged group info is reported again every c_heartbeatTicks reports, in case the
+    // rpc or the gateway restarts on the same endpoint
+    uint64_t m_reportTicks = 0;
+    static constexpr uint64_t c_heartbeatTicks = 10;
 };
 }  // namespace initializer
 }  // namespace bcos
\ No newline at end of file
@@ -2,25 +2,275 @@
 
 #include "bcos-executor/TransactionExecutor.h"
 #include "interfaces/executor/ExecutionMessage.h"
+#include "libinitializer/Common.h"
 #include "libutilities/ThreadPool.h"
 #include <bcos-framework/interfaces/executor/ParallelTransactionExecutorInterface.h>
 #include <bcos-framework/libutilities/ThreadPool.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
 #include <thread>
 
 namespace bcos::initializer
 {
+// the [executor] options of the ParallelExecutor threads
+struct ParallelExecutorConfig
+{
+    using Ptr = std::shared_ptr<ParallelExecutorConfig>;
+    size_t workerNum = std::thread::hardware_concurrency();
+    // the cpus the executor threads are bound to, empty means not bound
+    std::set<int> cpuAffinity;
+    // the threads of the read-only lane for call, getCode and getHash
+    size_t callWorkerNum = std::max(1u, std::thread::hardware_concurrency() / 4);
+    // the max pending requests of the read-only lane, the exceeded requests are rejected
+    size_t callQueueLimit = 10000;
+    // the backend of the execution tasks: pool(the FIFO ThreadPool) or tbb(work-stealing)
+    std::string taskScheduler = "pool";
+    // the in-process executors registered to the ExecutorManager, they share one cache
+    // Note: only 1 is accepted for now, the 2PC of several executors over the shared cache is
+    // not proven to reach the state of one executor, and the contracts are not dispatched by a
+    // stable (consistent hashing) policy yet
+    size_t executorNum = 1;
+
+    // the config of one of the executors, the threads are divided among all the executors
+    ParallelExecutorConfig::Ptr executorShardConfig() const
+    {
+        auto config = std::make_shared<ParallelExecutorConfig>(*this);
+        config->workerNum = std::max((size_t)1, workerNum / executorNum);
+        config->callWorkerNum = std::max((size_t)1, callWorkerNum / executorNum);
+        config->callQueueLimit = std::max((size_t)1, callQueueLimit / executorNum);
+        return config;
+    }
+
+    static ParallelExecutorConfig::Ptr load(boost::property_tree::ptree const& _pt)
+    {
+        auto config = std::make_shared<ParallelExecutorConfig>();
+        config->workerNum = _pt.get<size_t>("executor.worker_num", config->workerNum);
+        if (config->workerNum == 0)
+        {
+            config->workerNum = std::thread::hardware_concurrency();
+        }
+        config->callWorkerNum = _pt.get<size_t>("executor.call_worker_num", config->callWorkerNum);
+        if (config->callWorkerNum == 0)
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig()
+                                  << errinfo_comment("executor.call_worker_num must be positive"));
+        }
+        config->callQueueLimit =
+            _pt.get<size_t>("executor.call_queue_limit", config->callQueueLimit);
+        config->taskScheduler =
+            _pt.get<std::string>("executor.task_scheduler", config->taskScheduler);
+        if (config->taskScheduler != "pool" && config->taskScheduler != "tbb")
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "invalid executor.task_scheduler: " + config->taskScheduler +
+                                      ", must be pool or tbb"));
+        }
+        config->executorNum = _pt.get<size_t>("executor.executor_num", config->executorNum);
+        if (config->executorNum != 1)
+        {
+            BOOST_THROW_EXCEPTION(
+                bcos::tool::InvalidConfig() << errinfo_comment(
+                    "invalid executor.executor_num: " + std::to_string(config->executorNum) +
+                    ", only 1 in-process executor is supported now"));
+        }
+        // the cpu list, e.g. 0-3,8
+        auto cpuAffinity = _pt.get<std::string>("executor.cpu_affinity", "");
+        if (!cpuAffinity.empty())
+        {
+            config->cpuAffinity = parseCpuList(cpuAffinity);
+        }
+        // bind to the cpus of the numa node, intersected with the cpu_affinity if both are set
+        auto numaNode = _pt.get<int>("executor.numa_node", -1);
+        if (numaNode >= 0)
+        {
+            auto cpuListPath =
+                "/sys/devices/system/node/node" + std::to_string(numaNode) + "/cpulist";
+            auto content = readContentsToString(boost::filesystem::path(cpuListPath));
+            if (!content || content->empty())
+            {
+                BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                          "invalid executor.numa_node, read " + cpuListPath +
+                                          " failed"));
+            }
+            auto numaCpus = parseCpuList(*content);
+            if (config->cpuAffinity.empty())
+            {
+                config->cpuAffinity = numaCpus;
+            }
+            else
+            {
+                std::set<int> intersection;
+                std::set_intersection(config->cpuAffinity.begin(), config->cpuAffinity.end(),
+                    numaCpus.begin(), numaCpus.end(),
+                    std::inserter(intersection, intersection.begin()));
+                config->cpuAffinity = std::move(intersection);
+            }
+            if (config->cpuAffinity.empty())
+            {
+                BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                          "executor.cpu_affinity has no cpu of the "
+                                          "executor.numa_node"));
+            }
+        }
+        INITIALIZER_LOG(INFO) << LOG_DESC("loadParallelExecutorConfig")
+                              << LOG_KV("workerNum", config->workerNum)
+                              << LOG_KV("taskScheduler", config->taskScheduler)
+                              << LOG_KV("callWorkerNum", config->callWorkerNum)
+                              << LOG_KV("callQueueLimit", config->callQueueLimit)
+                              << LOG_KV("executorNum", config->executorNum)
+                              << LOG_KV("cpuAffinity", cpuAffinity)
+                              << LOG_KV("numaNode", numaNode)
+                              << LOG_KV("boundCpus", config->cpuAffinity.size());
+        return config;
+    }
+
+    static std::set<int> parseCpuList(std::string const& _cpuList)
+    {
+        std::set<int> cpus;
+        std::vector<std::string> ranges;
+        boost::split(ranges, _cpuList, boost::is_any_of(","));
+        for (auto& range : ranges)
+        {
+            boost::trim(range);
+            if (range.empty())
+            {
+                continue;
+            }
+            try
+            {
+                auto pos = range.find('-');
+                auto first = boost::lexical_cast<int>(range.substr(0, pos));
+                auto last = (pos == std::string::npos) ?
+                                first :
+                                boost::lexical_cast<int>(range.substr(pos + 1));
+                if (first < 0 || last < first || last >= CPU_SETSIZE)
+                {
+                    throw boost::bad_lexical_cast();
+                }
+                for (auto cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.insert(cpu);
+                }
+            }
+            catch (boost::bad_lexical_cast const&)
+            {
+                BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig()
+                                      << errinfo_comment("invalid cpu list: " + _cpuList));
+            }
+        }
+        return cpus;
+    }
+};
+
+// the workers of tbb are shared by all the arenas of the process, they are bound to the cpus while
+// working in the observed arena and restored when they leave it
+class ArenaCpuObserver : public tbb::task_scheduler_observer
+{
+public:
+    ArenaCpuObserver(tbb::task_arena& _arena, cpu_set_t const& _cpuSet)
+      : tbb::task_scheduler_observer(_arena), m_cpuSet(_cpuSet)
+    {
+        observe(true);
+    }
+    ~ArenaCpuObserver() override { observe(false); }
+
+    void on_scheduler_entry(bool) override
+    {
+        auto& savedCpuSet = originCpuSet();
+        if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &savedCpuSet.second) != 0)
+        {
+            savedCpuSet.first = false;
+            return;
+        }
+        savedCpuSet.first = true;
+        auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_cpuSet);
+        if (ret != 0)
+        {
+            INITIALIZER_LOG(WARNING)
+                << LOG_DESC("bind the executor thread to cpus failed") << LOG_KV("errno", ret);
+        }
+    }
+
+    void on_scheduler_exit(bool) override
+    {
+        auto& savedCpuSet = originCpuSet();
+        if (!savedCpuSet.first)
+        {
+            return;
+        }
+        savedCpuSet.first = false;
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &savedCpuSet.second);
+    }
+
+private:
+    // the affinity of the thread before entering the arena
+    static std::pair<bool, cpu_set_t>& originCpuSet()
+    {
+        thread_local std::pair<bool, cpu_set_t> cpuSet;
+        return cpuSet;
+    }
+
+    cpu_set_t m_cpuSet;
+};
+
 class ParallelExecutor : public executor::ParallelTransactionExecutorInterface
 {
 public:
-    ParallelExecutor(bcos::executor::TransactionExecutor::Ptr executor)
-      : m_pool("exec", std::thread::hardware_concurrency()), m_executor(std::move(executor))
-    {}
-    ~ParallelExecutor() noexcept override {}
+    ParallelExecutor(bcos::executor::TransactionExecutor::Ptr executor,
+        ParallelExecutorConfig::Ptr config = std::make_shared<ParallelExecutorConfig>())
+      : m_callQueueLimit(config->callQueueLimit),
+        m_executor(std::move(executor)),
+        m_callPool("execCall", config->callWorkerNum)
+    {
+        if (config->taskScheduler == "tbb")
+        {
+            // the nested tasks posted by the running tasks are stolen by the idle workers
+            m_arena = std::make_unique<tbb::task_arena>((int)config->workerNum);
+        }
+        else
+        {
+            m_pool = std::make_unique<bcos::ThreadPool>("exec", config->workerNum);
+        }
+        CPU_ZERO(&m_cpuSet);
+        for (auto cpu : config->cpuAffinity)
+        {
+            CPU_SET(cpu, &m_cpuSet);
+        }
+        m_bindCpu = !config->cpuAffinity.empty();
+        if (m_arena && m_bindCpu)
+        {
+            m_arena->initialize();
+            m_cpuObserver = std::make_unique<ArenaCpuObserver>(*m_arena, m_cpuSet);
+        }
+    }
+    ~ParallelExecutor() noexcept override
+    {
+        if (m_arena)
+        {
+            // the arena never waits for the enqueued tasks when it is destroyed
+            std::unique_lock<std::mutex> lock(m_arenaTasksMutex);
+            m_arenaTasksCV.wait(lock, [this]() { return m_arenaTasks == 0; });
+        }
+        m_cpuObserver.reset();
+    }
 
     void nextBlockHeader(const bcos::protocol::BlockHeader::ConstPtr& blockHeader,
         std::function<void(bcos::Error::UniquePtr)> callback) override
     {
-        m_pool.enqueue(
+        enqueue(
             [this, blockHeader = std::move(blockHeader), callback = std::move(callback)]() {
                 m_executor->nextBlockHeader(blockHeader, std::move(callback));
             });
@@ -30,7 +280,7 @@ public:
         std::function<void(bcos::Error::UniquePtr, bcos::protocol::ExecutionMessage::UniquePtr)>
             callback) override
     {
-        m_pool.enqueue([this, inputRaw = input.release(), callback = std::move(callback)] {
+        enqueue([this, inputRaw = input.release(), callback = std::move(callback)] {
             m_executor->executeTransaction(
                 bcos::protocol::ExecutionMessage::UniquePtr(inputRaw), std::move(callback));
         });
@@ -41,26 +291,47 @@ public:
             bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
             callback) override
     {
-        m_pool.enqueue([this, inputs = std::move(inputs), callback = std::move(callback)] {
+        enqueue([this, inputs = std::move(inputs), callback = std::move(callback)] {
             m_executor->dagExecuteTransactions(std::move(inputs), std::move(callback));
         });
     }
 
+    // Note: the read-only requests run in the call lane, never delay the block execution
     void call(bcos::protocol::ExecutionMessage::UniquePtr input,
         std::function<void(bcos::Error::UniquePtr, bcos::protocol::ExecutionMessage::UniquePtr)>
             callback) override
     {
-        m_pool.enqueue([this, inputRaw = input.release(), callback = std::move(callback)] {
-            m_executor->call(
-                bcos::protocol::ExecutionMessage::UniquePtr(inputRaw), std::move(callback));
+        if (!acquireCallSlot())
+        {
+            callback(BCOS_ERROR_UNIQUE_PTR(c_callQueueFull, "call queue full"), nullptr);
+            return;
+        }
+        auto startT = std::chrono::steady_clock::now();
+        enqueueCall([this, inputRaw = input.release(), startT, callback = std::move(callback)] {
+            m_executor->call(bcos::protocol::ExecutionMessage::UniquePtr(inputRaw),
+                [this, startT, callback](bcos::Error::UniquePtr error,
+                    bcos::protocol::ExecutionMessage::UniquePtr output) {
+                    releaseCallSlot(startT);
+                    callback(std::move(error), std::move(output));
+                });
         });
     }
 
     void getHash(bcos::protocol::BlockNumber number,
         std::function<void(bcos::Error::UniquePtr, crypto::HashType)> callback) override
     {
-        m_pool.enqueue([this, number, callback = std::move(callback)] {
-            m_executor->getHash(number, std::move(callback));
+        if (!acquireCallSlot())
+        {
+            callback(BCOS_ERROR_UNIQUE_PTR(c_callQueueFull, "call queue full"), crypto::HashType());
+            return;
+        }
+        auto startT = std::chrono::steady_clock::now();
+        enqueueCall([this, number, startT, callback = std::move(callback)] {
+            m_executor->getHash(number,
+                [this, startT, callback](bcos::Error::UniquePtr error, crypto::HashType hash) {
+                    releaseCallSlot(startT);
+                    callback(std::move(error), std::move(hash));
+                });
         });
     }
 
@@ -69,7 +340,7 @@ public:
     // Write data to storage uncommitted
     void prepare(const TwoPCParams& params, std::function<void(bcos::Error::Ptr)> callback) override
     {
-        m_pool.enqueue([this, params = TwoPCParams(params), callback = std::move(callback)] {
+        enqueue([this, params = TwoPCParams(params), callback = std::move(callback)] {
             m_executor->prepare(params, std::move(callback));
         });
     }
@@ -77,7 +348,7 @@ public:
     // Commit uncommitted data
     void commit(const TwoPCParams& params, std::function<void(bcos::Error::Ptr)> callback) override
     {
-        m_pool.enqueue([this, params = TwoPCParams(params), callback = std::move(callback)] {
+        enqueue([this, params = TwoPCParams(params), callback = std::move(callback)] {
             m_executor->commit(params, std::move(callback));
         });
     }
@@ -86,7 +357,7 @@ public:
     void rollback(
         const TwoPCParams& params, std::function<void(bcos::Error::Ptr)> callback) override
     {
-        m_pool.enqueue([this, params = TwoPCParams(params), callback = std::move(callback)] {
+        enqueue([this, params = TwoPCParams(params), callback = std::move(callback)] {
             m_executor->rollback(params, std::move(callback));
         });
     }
@@ -96,19 +367,149 @@ public:
     // drop all status
     void reset(std::function<void(bcos::Error::Ptr)> callback) override
     {
-        m_pool.enqueue(
+        enqueue(
             [this, callback = std::move(callback)] { m_executor->reset(std::move(callback)); });
     }
     void getCode(std::string_view contract,
         std::function<void(bcos::Error::Ptr, bcos::bytes)> callback) override
     {
-        m_pool.enqueue([this, contract = std::string(contract), callback = std::move(callback)] {
-            m_executor->getCode(contract, std::move(callback));
-        });
+        if (!acquireCallSlot())
+        {
+            callback(BCOS_ERROR_PTR(c_callQueueFull, "call queue full"), bcos::bytes());
+            return;
+        }
+        auto startT = std::chrono::steady_clock::now();
+        enqueueCall(
+            [this, contract = std::string(contract), startT, callback = std::move(callback)] {
+                m_executor->getCode(
+                    contract, [this, startT, callback](bcos::Error::Ptr error, bcos::bytes code) {
+                        releaseCallSlot(startT);
+                        callback(std::move(error), std::move(code));
+                    });
+            });
     }
 
 private:
-    bcos::ThreadPool m_pool;
+    template <class F>
+    void enqueue(F _task)
+    {
+        if (m_arena)
+        {
+            // enqueue returns at once, unlike execute it never makes the caller join the arena
+            // and wait for a slot; the cpus of the workers are bound by m_cpuObserver
+            {
+                std::lock_guard<std::mutex> lock(m_arenaTasksMutex);
+                m_arenaTasks++;
+            }
+            m_arena->enqueue([this, task = std::move(_task)]() {
+                task();
+                std::lock_guard<std::mutex> lock(m_arenaTasksMutex);
+                if (--m_arenaTasks == 0)
+                {
+                    m_arenaTasksCV.notify_all();
+                }
+            });
+            return;
+        }
+        m_pool->enqueue([this, task = std::move(_task)]() mutable {
+            bindCpu();
+            task();
+        });
+    }
+
+    // the call threads are not bound to the executor cpus and run with a lower priority
+    template <class F>
+    void enqueueCall(F _task)
+    {
+        m_callPool.enqueue([task = std::move(_task)]() mutable {
+            thread_local bool niced = false;
+            if (!niced)
+            {
+                niced = true;
+                setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), c_callThreadNice);
+            }
+            task();
+        });
+    }
+
+    bool acquireCallSlot()
+    {
+        if (m_pendingCalls.fetch_add(1) >= m_callQueueLimit)
+        {
+            m_pendingCalls.fetch_sub(1);
+            m_rejectedCalls++;
+            return false;
+        }
+        return true;
+    }
+
+    // report the latency of the call lane every c_callReportInterval requests
+    void releaseCallSlot(std::chrono::steady_clock::time_point _startT)
+    {
+        m_pendingCalls.fetch_sub(1);
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - _startT)
+                           .count();
+        m_callLatencySum += latency;
+        auto maxLatency = m_callLatencyMax.load();
+        while (latency > maxLatency && !m_callLatencyMax.compare_exchange_weak(maxLatency, latency))
+        {
+        }
+        if (++m_finishedCalls % c_callReportInterval != 0)
+        {
+            return;
+        }
+        INITIALIZER_LOG(INFO) << LOG_BADGE("METRIC") << LOG_DESC("ParallelExecutor call lane")
+                              << LOG_KV("avgLatencyUs", m_callLatencySum.exchange(0) /
+                                                            c_callReportInterval)
+                              << LOG_KV("maxLatencyUs", m_callLatencyMax.exchange(0))
+                              << LOG_KV("pending", m_pendingCalls.load())
+                              << LOG_KV("rejected", m_rejectedCalls.load());
+    }
+
+    // the threads of the ThreadPool are dedicated but not exposed, bind them on their first task
+    void bindCpu()
+    {
+        thread_local bool bound = false;
+        if (!m_bindCpu || bound)
+        {
+            return;
+        }
+        bound = true;
+        auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_cpuSet);
+        if (ret != 0)
+        {
+            INITIALIZER_LOG(WARNING)
+                << LOG_DESC("bind the executor thread to cpus failed") << LOG_KV("errno", ret);
+        }
+    }
+
+    size_t m_callQueueLimit;
     bcos::executor::TransactionExecutor::Ptr m_executor;
+    cpu_set_t m_cpuSet;
+    bool m_bindCpu = false;
+
+    std::atomic<size_t> m_pendingCalls = {0};
+    std::atomic<uint64_t> m_rejectedCalls = {0};
+    std::atomic<uint64_t> m_finishedCalls = {0};
+    std::atomic<int64_t> m_callLatencySum = {0};
+    std::atomic<int64_t> m_callLatencyMax = {0};
+
+    // the tasks enqueued to m_arena and not finished yet
+    size_t m_arenaTasks = 0;
+    std::mutex m_arenaTasksMutex;
+    std::condition_variable m_arenaTasksCV;
+
+    // Note: the threads are declared after all the members their tasks use, they are joined
+    // before those members are destroyed
+    bcos::ThreadPool m_callPool;
+    // only one of m_pool and m_arena is created according to the taskScheduler
+    std::unique_ptr<bcos::ThreadPool> m_pool;
+    std::unique_ptr<tbb::task_arena> m_arena;
+    std::unique_ptr<ArenaCpuObserver> m_cpuObserver;
+
+    static constexpr int c_callThreadNice = 10;
+    static constexpr uint64_t c_callReportInterval = 10000;
+    static constexpr int32_t c_callQueueFull = -1;
 };
 }  // namespace bcos::initializer
\ No newline at end of file
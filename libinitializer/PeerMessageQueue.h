@@ -0,0 +1,156 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the bounded per-peer queues of the inbound messages of one module
+ * @file PeerMessageQueue.h
+ * @date 2021-11-24
+ */
+#pragma once
+#include "libinitializer/ModuleDispatcher.h"
+#include <bcos-framework/interfaces/crypto/KeyInterface.h>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace bcos::initializer
+{
+// every peer owns a queue of at most _capacity messages, the oldest message is dropped when the
+// queue is full, so that a flooding peer only sheds its own messages
+// the peers are served in turn, one message per dispatch, the messages of one peer are handled
+// one by one in the order they arrive
+class PeerMessageQueue
+{
+public:
+    using Ptr = std::shared_ptr<PeerMessageQueue>;
+    PeerMessageQueue(
+        std::string const& _name, size_t _workerNum, int _niceValue, size_t _capacity)
+      : m_capacity(_capacity), m_dispatcher(_name, _workerNum, _niceValue)
+    {}
+
+    void enqueue(bcos::crypto::NodeIDPtr _nodeID, std::function<void()> _task)
+    {
+        bool schedule = false;
+        bool congested = false;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            auto& peerQueue = m_peerQueues[_nodeID->data()];
+            if (peerQueue.tasks.size() >= m_capacity)
+            {
+                peerQueue.tasks.pop_front();
+                --m_pendingMessages;
+                ++m_droppedMessages;
+                // only warn once until the peer drains half of its queue
+                congested = !peerQueue.congested;
+                peerQueue.congested = true;
+            }
+            peerQueue.tasks.emplace_back(std::move(_task));
+            ++m_pendingMessages;
+            schedule = !peerQueue.scheduled;
+            peerQueue.scheduled = true;
+        }
+        if (congested)
+        {
+            INITIALIZER_LOG(WARNING)
+                << LOG_DESC("PeerMessageQueue: the peer is congested, drop the oldest message")
+                << LOG_KV("module", m_dispatcher.name()) << LOG_KV("peer", _nodeID->shortHex())
+                << LOG_KV("capacity", m_capacity) << LOG_KV("dropped", m_droppedMessages);
+        }
+        if (schedule)
+        {
+            dispatch(_nodeID->data());
+        }
+    }
+
+    std::string const& name() const { return m_dispatcher.name(); }
+    // the messages waiting for the dispatch
+    size_t pendingMessages() const { return m_pendingMessages; }
+    uint64_t droppedMessages() const { return m_droppedMessages; }
+    // the peer has dropped messages since its queue is drained to half of the capacity
+    bool congested(bcos::crypto::NodeIDPtr const& _nodeID) const
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        auto it = m_peerQueues.find(_nodeID->data());
+        return it != m_peerQueues.end() && it->second.congested;
+    }
+
+private:
+    struct PeerQueue
+    {
+        std::deque<std::function<void()>> tasks;
+        // a dispatch of the peer is waiting in the pool or running
+        bool scheduled = false;
+        bool congested = false;
+    };
+
+    void dispatch(bcos::bytes const& _peer)
+    {
+        m_dispatcher.enqueue([this, peer = _peer]() {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> l(m_mutex);
+                auto it = m_peerQueues.find(peer);
+                if (it == m_peerQueues.end())
+                {
+                    return;
+                }
+                auto& peerQueue = it->second;
+                task = std::move(peerQueue.tasks.front());
+                peerQueue.tasks.pop_front();
+                --m_pendingMessages;
+                if (peerQueue.tasks.size() <= m_capacity / 2)
+                {
+                    peerQueue.congested = false;
+                }
+            }
+            // the peer stays scheduled until the task finishes, the next message of the peer is
+            // never handled by another worker meanwhile
+            try
+            {
+                task();
+            }
+            catch (std::exception const& e)
+            {
+                INITIALIZER_LOG(WARNING) << LOG_DESC("PeerMessageQueue: handle message failed")
+                                         << LOG_KV("module", m_dispatcher.name())
+                                         << LOG_KV("error", boost::diagnostic_information(e));
+            }
+            bool hasMore = false;
+            {
+                std::lock_guard<std::mutex> l(m_mutex);
+                auto it = m_peerQueues.find(peer);
+                hasMore = (it != m_peerQueues.end() && !it->second.tasks.empty());
+                if (!hasMore && it != m_peerQueues.end())
+                {
+                    m_peerQueues.erase(it);
+                }
+            }
+            // requeue the peer behind the others instead of draining it in a loop
+            if (hasMore)
+            {
+                dispatch(peer);
+            }
+        });
+    }
+
+private:
+    size_t m_capacity;
+    mutable std::mutex m_mutex;
+    std::map<bcos::bytes, PeerQueue> m_peerQueues;
+    std::atomic<size_t> m_pendingMessages = {0};
+    std::atomic<uint64_t> m_droppedMessages = {0};
+    // destroyed first, the running tasks are joined before the queues are released
+    ModuleDispatcher m_dispatcher;
+};
+}  // namespace bcos::initializer
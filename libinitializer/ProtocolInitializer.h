@@ -20,6 +20,7 @@
  */
 #pragma once
 #include "libinitializer/Common.h"
+#include "libinitializer/NodeIDCache.h"
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-framework/interfaces/crypto/CryptoSuite.h>
 #include <bcos-framework/interfaces/protocol/BlockFactory.h>
@@ -34,7 +35,11 @@ class ProtocolInitializer
 {
 public:
     using Ptr = std::shared_ptr<ProtocolInitializer>;
-    ProtocolInitializer() : m_keyFactory(std::make_shared<bcos::crypto::KeyFactoryImpl>()) {}
+    // the nodeIDs of the inbound messages decoded by the servants are interned by the NodeIDCache
+    ProtocolInitializer()
+      : m_keyFactory(
+            std::make_shared<NodeIDCache>(std::make_shared<bcos::crypto::KeyFactoryImpl>()))
+    {}
     virtual ~ProtocolInitializer() {}
 
     virtual void init(bcos::tool::NodeConfig::Ptr _nodeConfig);
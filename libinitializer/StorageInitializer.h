@@ -24,31 +24,423 @@
  */
 #pragma once
 #include "boost/filesystem.hpp"
+#include "libinitializer/Common.h"
 #include <bcos-framework/interfaces/storage/StorageInterface.h>
 #include <bcos-storage/RocksDBStorage.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
+#include <rocksdb/utilities/checkpoint.h>
 #include <rocksdb/write_batch.h>
+#include <thread>
 
 namespace bcos::initializer
 {
+// extract the table name of the key encoded by RocksDBStorage as "table:key"
+class TablePrefixExtractor : public rocksdb::SliceTransform
+{
+public:
+    const char* Name() const override { return "bcos.TablePrefixExtractor"; }
+
+    rocksdb::Slice Transform(const rocksdb::Slice& _key) const override
+    {
+        auto pos = std::string_view(_key.data(), _key.size()).find(c_tableKeySplit);
+        return rocksdb::Slice(_key.data(), pos + 1);
+    }
+
+    bool InDomain(const rocksdb::Slice& _key) const override
+    {
+        return std::string_view(_key.data(), _key.size()).find(c_tableKeySplit) !=
+               std::string_view::npos;
+    }
+
+private:
+    // Note: must be the same with the TABLE_KEY_SPLIT of bcos-storage, the keys without the
+    // split are out of the domain and fall back to the total order seek
+    static constexpr char c_tableKeySplit = ':';
+};
+
+// the rocksDB tuning options of the [storage] section
+struct StorageConfig
+{
+    using Ptr = std::shared_ptr<StorageConfig>;
+    std::string profile = "balanced";
+    size_t blockCacheSize = 128 * 1024 * 1024;
+    size_t writeBufferSize = 64 * 1024 * 1024;
+    int maxWriteBufferNumber = 3;
+    int maxBackgroundJobs = 4;
+    bool bloomFilter = true;
+    // build the bloom filter of the memtable and SST files on the table name, off by default:
+    // with the prefix extractor the iterators of RocksDBStorage, which don't set
+    // total_order_seek, stop at the end of the table of the seek key, so it's only safe for the
+    // storage that never scans across the tables.
+    // Note: the SST files written before it's turned on have no prefix filter and are still
+    // read in total order, they get the filter when they are compacted
+    bool tablePrefixBloom = false;
+    rocksdb::CompactionStyle compactionStyle = rocksdb::kCompactionStyleLevel;
+    // the rocksDB pipelined write only overlaps the concurrent writers, the blocks are committed
+    // one by one, so it's off by default
+    bool pipelinedWrite = false;
+    // sync the SST files and the WAL in the background every bytesPerSync bytes, smooths the
+    // large fsync of the flushes and compactions into small steps
+    uint64_t bytesPerSync = 1024 * 1024;
+    // lower the cpu priority of the compaction threads below the executor threads
+    bool lowPriorityCompaction = false;
+    // the checkpoint of the state and the blocks written when the storage is opened
+    std::string snapshotExportPath;
+    // the checkpoint copied into the empty storage before it's opened, the node syncs the blocks
+    // after the checkpoint instead of executing all the blocks from the genesis
+    std::string snapshotImportPath;
+
+    // the memory the profile is allowed to use: block cache plus all the memtables
+    size_t memoryBudget() const
+    {
+        return blockCacheSize + writeBufferSize * (size_t)maxWriteBufferNumber;
+    }
+};
+
+// the chain of the node, recorded into the exported snapshot and checked before the snapshot is
+// imported
+struct SnapshotIdentity
+{
+    using Ptr = std::shared_ptr<SnapshotIdentity>;
+    std::string chainId;
+    std::string groupId;
+    // check the blocks of the snapshot opened read-only, throws if the genesis block is not the
+    // genesis of the node
+    std::function<void(bcos::storage::StorageInterface::Ptr)> checkBlocks;
+
+    std::string encode() const { return chainId + "\n" + groupId + "\n"; }
+};
+
 class StorageInitializer
 {
 public:
-    static bcos::storage::TransactionalStorageInterface::Ptr build(std::string const& _storagePath)
+    static StorageConfig::Ptr loadConfig(boost::property_tree::ptree const& _pt)
+    {
+        auto config = std::make_shared<StorageConfig>();
+        config->profile = _pt.get<std::string>("storage.profile", "balanced");
+        if (config->profile == "low_memory")
+        {
+            // ~64MB in total
+            config->blockCacheSize = 32 * 1024 * 1024;
+            config->writeBufferSize = 16 * 1024 * 1024;
+            config->maxWriteBufferNumber = 2;
+            config->maxBackgroundJobs = 2;
+        }
+        else if (config->profile == "balanced")
+        {
+            // ~320MB in total, the default StorageConfig
+        }
+        else if (config->profile == "high_throughput")
+        {
+            // ~1GB in total
+            config->blockCacheSize = 512 * 1024 * 1024;
+            config->writeBufferSize = 128 * 1024 * 1024;
+            config->maxWriteBufferNumber = 4;
+            config->maxBackgroundJobs =
+                std::max(4, (int)(std::thread::hardware_concurrency() / 2));
+        }
+        else
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "invalid storage.profile: " + config->profile +
+                                      ", must be low_memory, balanced or high_throughput"));
+        }
+        // the explicit options override the profile, the sizes are in MB
+        config->blockCacheSize =
+            _pt.get<size_t>("storage.block_cache_size", config->blockCacheSize / 1024 / 1024) *
+            1024 * 1024;
+        config->writeBufferSize =
+            _pt.get<size_t>("storage.write_buffer_size", config->writeBufferSize / 1024 / 1024) *
+            1024 * 1024;
+        config->maxWriteBufferNumber =
+            _pt.get<int>("storage.max_write_buffer_number", config->maxWriteBufferNumber);
+        config->maxBackgroundJobs =
+            _pt.get<int>("storage.max_background_jobs", config->maxBackgroundJobs);
+        config->bloomFilter = _pt.get<bool>("storage.bloom_filter", config->bloomFilter);
+        config->tablePrefixBloom =
+            _pt.get<bool>("storage.table_prefix_bloom", config->tablePrefixBloom);
+        config->pipelinedWrite = _pt.get<bool>("storage.pipelined_write", config->pipelinedWrite);
+        config->lowPriorityCompaction =
+            _pt.get<bool>("storage.low_priority_compaction", config->lowPriorityCompaction);
+        // in KB, 0 means sync only when the file is closed
+        config->bytesPerSync =
+            _pt.get<uint64_t>("storage.bytes_per_sync", config->bytesPerSync / 1024) * 1024;
+        config->snapshotExportPath = _pt.get<std::string>("storage.snapshot_export_path", "");
+        config->snapshotImportPath = _pt.get<std::string>("storage.snapshot_import_path", "");
+        auto compactionStyle = _pt.get<std::string>("storage.compaction_style", "");
+        if (compactionStyle == "level")
+        {
+            config->compactionStyle = rocksdb::kCompactionStyleLevel;
+        }
+        else if (compactionStyle == "universal")
+        {
+            config->compactionStyle = rocksdb::kCompactionStyleUniversal;
+        }
+        else if (!compactionStyle.empty())
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "invalid storage.compaction_style: " + compactionStyle +
+                                      ", must be level or universal"));
+        }
+        if (config->maxWriteBufferNumber < 1 || config->maxBackgroundJobs < 1)
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "storage.max_write_buffer_number and "
+                                      "storage.max_background_jobs must be positive"));
+        }
+        INITIALIZER_LOG(INFO) << LOG_DESC("loadStorageConfig")
+                              << LOG_KV("profile", config->profile)
+                              << LOG_KV("blockCacheSize", config->blockCacheSize)
+                              << LOG_KV("writeBufferSize", config->writeBufferSize)
+                              << LOG_KV("maxWriteBufferNumber", config->maxWriteBufferNumber)
+                              << LOG_KV("maxBackgroundJobs", config->maxBackgroundJobs)
+                              << LOG_KV("bloomFilter", config->bloomFilter)
+                              << LOG_KV("tablePrefixBloom", config->tablePrefixBloom)
+                              << LOG_KV("compactionStyle", config->compactionStyle)
+                              << LOG_KV("pipelinedWrite", config->pipelinedWrite)
+                              << LOG_KV("bytesPerSync", config->bytesPerSync)
+                              << LOG_KV("lowPriorityCompaction", config->lowPriorityCompaction)
+                              << LOG_KV("memoryBudget", config->memoryBudget())
+                              << LOG_KV("snapshotExportPath", config->snapshotExportPath)
+                              << LOG_KV("snapshotImportPath", config->snapshotImportPath);
+        return config;
+    }
+
+    // _blockCache: the block cache shared with the node-wide memory budget, created from the
+    // StorageConfig if not set
+    // _identity: required to export or import the snapshot
+    static bcos::storage::TransactionalStorageInterface::Ptr build(std::string const& _storagePath,
+        StorageConfig::Ptr _config = nullptr, std::shared_ptr<rocksdb::Cache> _blockCache = nullptr,
+        SnapshotIdentity::Ptr _identity = nullptr)
     {
+        if (!_config)
+        {
+            _config = std::make_shared<StorageConfig>();
+        }
+        if ((!_config->snapshotImportPath.empty() || !_config->snapshotExportPath.empty()) &&
+            !_identity)
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "the snapshot is not supported by the storage of " +
+                                      _storagePath));
+        }
+        if (!_config->snapshotImportPath.empty())
+        {
+            importSnapshot(_config->snapshotImportPath, _storagePath, *_identity);
+        }
         boost::filesystem::create_directories(_storagePath);
         rocksdb::DB* db;
         rocksdb::Options options;
-        // Note: This option will increase much memory
-        // options.IncreaseParallelism();
-        // Note: This option will increase much memory
-        // options.OptimizeLevelStyleCompaction();
+        // Note: IncreaseParallelism() and OptimizeLevelStyleCompaction() size the memtables
+        // without any bound, the profile of the StorageConfig is used instead
+        options.max_background_jobs = _config->maxBackgroundJobs;
+        options.write_buffer_size = _config->writeBufferSize;
+        options.max_write_buffer_number = _config->maxWriteBufferNumber;
+        options.compaction_style = _config->compactionStyle;
+        options.enable_pipelined_write = _config->pipelinedWrite;
+        options.bytes_per_sync = _config->bytesPerSync;
+        options.wal_bytes_per_sync = _config->bytesPerSync;
+        if (_config->lowPriorityCompaction)
+        {
+            // the compactions run in the LOW pool, the flushes of the HIGH pool keep the priority
+            options.env->LowerThreadPoolCPUPriority(rocksdb::Env::Priority::LOW);
+        }
+        if (_config->compactionStyle == rocksdb::kCompactionStyleLevel)
+        {
+            // keep the L1 size the same as L0 to avoid the write stall of L0->L1 compaction
+            options.max_bytes_for_level_base =
+                _config->writeBufferSize * (uint64_t)_config->maxWriteBufferNumber;
+        }
+
+        rocksdb::BlockBasedTableOptions tableOptions;
+        tableOptions.block_cache =
+            _blockCache ? _blockCache : rocksdb::NewLRUCache(_config->blockCacheSize);
+        if (_blockCache)
+        {
+            // the index and filter blocks are charged to the budget instead of the table readers,
+            // the blocks of L0 are read by every lookup and kept in the cache
+            tableOptions.cache_index_and_filter_blocks = true;
+            tableOptions.pin_l0_filter_and_index_blocks_in_cache = true;
+        }
+        if (_config->bloomFilter)
+        {
+            tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+        }
+        if (_config->bloomFilter && _config->tablePrefixBloom)
+        {
+            // the point lookups still use the whole key filter, the table scans of
+            // asyncGetPrimaryKeys and the lookups of missing keys skip the SST files and
+            // memtables that contain no row of the table
+            tableOptions.whole_key_filtering = true;
+            options.prefix_extractor = std::make_shared<TablePrefixExtractor>();
+            options.memtable_prefix_bloom_size_ratio = 0.1;
+            options.memtable_whole_key_filtering = true;
+        }
+        options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tableOptions));
         // create the DB if it's not already present
         options.create_if_missing = true;
 
         // open DB
         rocksdb::Status s = rocksdb::DB::Open(options, _storagePath, &db);
+        if (!s.ok())
+        {
+            INITIALIZER_LOG(ERROR) << LOG_DESC("open rocksDB failed")
+                                   << LOG_KV("path", _storagePath)
+                                   << LOG_KV("status", s.ToString());
+            BOOST_THROW_EXCEPTION(
+                BCOS_ERROR(-1, "StorageInitializer: open rocksDB failed, " + s.ToString()));
+        }
+        if (!_config->snapshotExportPath.empty())
+        {
+            exportSnapshot(db, _config->snapshotExportPath, *_identity);
+        }
 
         return std::make_shared<bcos::storage::RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db));
     }
+
+    // the checkpoint hard links the SST files when the snapshot path is on the same filesystem,
+    // nothing has been written since the DB is opened, so the state and the blocks are of the same
+    // height
+    static void exportSnapshot(
+        rocksdb::DB* _db, std::string const& _snapshotPath, SnapshotIdentity const& _identity)
+    {
+        if (boost::filesystem::exists(_snapshotPath))
+        {
+            INITIALIZER_LOG(WARNING)
+                << LOG_DESC("exportSnapshot: the snapshot path already exists, skip the export")
+                << LOG_KV("path", _snapshotPath);
+            return;
+        }
+        rocksdb::Checkpoint* checkpoint;
+        auto s = rocksdb::Checkpoint::Create(_db, &checkpoint);
+        if (s.ok())
+        {
+            s = checkpoint->CreateCheckpoint(_snapshotPath);
+            delete checkpoint;
+        }
+        if (!s.ok())
+        {
+            INITIALIZER_LOG(ERROR) << LOG_DESC("exportSnapshot failed")
+                                   << LOG_KV("path", _snapshotPath)
+                                   << LOG_KV("status", s.ToString());
+            BOOST_THROW_EXCEPTION(
+                BCOS_ERROR(-1, "StorageInitializer: export snapshot failed, " + s.ToString()));
+        }
+        boost::filesystem::save_string_file(
+            boost::filesystem::path(_snapshotPath) / c_snapshotIdentityFile, _identity.encode());
+        INITIALIZER_LOG(INFO) << LOG_DESC("exportSnapshot success")
+                              << LOG_KV("path", _snapshotPath)
+                              << LOG_KV("chainId", _identity.chainId)
+                              << LOG_KV("groupId", _identity.groupId);
+    }
+
+    // the snapshot is only imported into an empty storage, the storage of a running node is
+    // never overwritten
+    // the snapshot is copied aside and checked before it's moved to the storage path: the identity
+    // recorded by the export, the checksums of all the SST files and the genesis block
+    static void importSnapshot(std::string const& _snapshotPath, std::string const& _storagePath,
+        SnapshotIdentity const& _identity)
+    {
+        auto storagePath = boost::filesystem::path(_storagePath);
+        if (boost::filesystem::exists(storagePath / "CURRENT"))
+        {
+            INITIALIZER_LOG(INFO)
+                << LOG_DESC("importSnapshot: the storage is not empty, skip the import")
+                << LOG_KV("storagePath", _storagePath);
+            return;
+        }
+        if (boost::filesystem::exists(storagePath) && !boost::filesystem::is_empty(storagePath))
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "import snapshot failed, the storage path " + _storagePath +
+                                      " is neither empty nor a rocksDB"));
+        }
+        auto snapshotPath = boost::filesystem::path(_snapshotPath);
+        if (!boost::filesystem::exists(snapshotPath / "CURRENT"))
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "invalid storage.snapshot_import_path: " + _snapshotPath +
+                                      ", not a rocksDB checkpoint"));
+        }
+        std::string identity;
+        if (boost::filesystem::exists(snapshotPath / c_snapshotIdentityFile))
+        {
+            boost::filesystem::load_string_file(snapshotPath / c_snapshotIdentityFile, identity);
+        }
+        if (identity != _identity.encode())
+        {
+            BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                      "invalid storage.snapshot_import_path: " + _snapshotPath +
+                                      ", the snapshot is not exported by the chain " +
+                                      _identity.chainId + " group " + _identity.groupId));
+        }
+
+        auto stagingPath = boost::filesystem::path(_storagePath + ".importing");
+        boost::filesystem::remove_all(stagingPath);
+        boost::filesystem::create_directories(stagingPath);
+        size_t files = 0;
+        for (auto const& entry : boost::filesystem::directory_iterator(snapshotPath))
+        {
+            if (!boost::filesystem::is_regular_file(entry.path()) ||
+                entry.path().filename() == c_snapshotIdentityFile)
+            {
+                continue;
+            }
+            boost::filesystem::copy_file(entry.path(), stagingPath / entry.path().filename(),
+                boost::filesystem::copy_options::overwrite_existing);
+            ++files;
+        }
+        try
+        {
+            checkSnapshot(stagingPath.string(), _identity);
+        }
+        catch (...)
+        {
+            boost::filesystem::remove_all(stagingPath);
+            throw;
+        }
+        boost::filesystem::remove_all(storagePath);
+        if (storagePath.has_parent_path())
+        {
+            boost::filesystem::create_directories(storagePath.parent_path());
+        }
+        boost::filesystem::rename(stagingPath, storagePath);
+        INITIALIZER_LOG(INFO) << LOG_DESC("importSnapshot success")
+                              << LOG_KV("snapshotPath", _snapshotPath)
+                              << LOG_KV("storagePath", _storagePath) << LOG_KV("files", files);
+    }
+
+    // throws if the copied snapshot is broken or not of the chain
+    static void checkSnapshot(std::string const& _path, SnapshotIdentity const& _identity)
+    {
+        rocksdb::DB* db;
+        rocksdb::Options options;
+        auto s = rocksdb::DB::OpenForReadOnly(options, _path, &db);
+        if (!s.ok())
+        {
+            BOOST_THROW_EXCEPTION(
+                BCOS_ERROR(-1, "StorageInitializer: open the snapshot failed, " + s.ToString()));
+        }
+        auto storage =
+            std::make_shared<bcos::storage::RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db));
+        s = db->VerifyChecksum();
+        if (!s.ok())
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(
+                -1, "StorageInitializer: verify the checksum of the snapshot failed, " +
+                        s.ToString()));
+        }
+        if (_identity.checkBlocks)
+        {
+            _identity.checkBlocks(storage);
+        }
+    }
+
+private:
+    // the file recording the SnapshotIdentity in the exported checkpoint
+    static constexpr const char* c_snapshotIdentityFile = "SNAPSHOT_IDENTITY";
 };
-}  // namespace bcos::initializer
\ No newline at end of file
+}  // namespace bcos::initializer
@@ -0,0 +1,142 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the download and commit rates of the block sync
+ * @file SyncRateStatistics.h
+ * @date 2021-11-27
+ */
+#pragma once
+#include "libinitializer/Common.h"
+#include <bcos-framework/interfaces/crypto/KeyInterface.h>
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <json/json.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace bcos::initializer
+{
+// the rates are measured over windows of _windowSize ms, the last complete window is reported
+class SyncRateStatistics
+{
+public:
+    using Ptr = std::shared_ptr<SyncRateStatistics>;
+    explicit SyncRateStatistics(uint64_t _windowSize = 5000)
+      : m_windowSize(std::chrono::milliseconds(_windowSize)),
+        m_windowStartT(std::chrono::steady_clock::now())
+    {}
+
+    // the block sync messages received from _nodeID
+    void onSyncMessage(bcos::crypto::NodeIDPtr const& _nodeID, size_t _size)
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        rotateWindow(std::chrono::steady_clock::now());
+        auto& peer = m_peers[_nodeID->hex()];
+        peer.windowBytes += _size;
+        ++peer.windowMessages;
+    }
+
+    // the latest block number committed by the consensus or the block sync
+    void onBlockNumber(bcos::protocol::BlockNumber _number)
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        rotateWindow(std::chrono::steady_clock::now());
+        if (m_windowStartNumber < 0)
+        {
+            m_windowStartNumber = _number;
+        }
+        m_latestNumber = std::max(m_latestNumber, _number);
+    }
+
+    // merge the rates into the sync info json of the block sync
+    std::string appendTo(std::string const& _syncInfo)
+    {
+        Json::Value syncInfo;
+        Json::Reader reader;
+        if (!reader.parse(_syncInfo, syncInfo) || !syncInfo.isObject())
+        {
+            return _syncInfo;
+        }
+        std::lock_guard<std::mutex> l(m_mutex);
+        rotateWindow(std::chrono::steady_clock::now());
+        syncInfo["commitRate"] = m_commitRate;
+        double downloadRate = 0;
+        Json::Value peerRates(Json::arrayValue);
+        for (auto const& it : m_peers)
+        {
+            Json::Value peerRate;
+            peerRate["nodeID"] = it.first;
+            peerRate["downloadRate"] = it.second.bytesRate;
+            peerRate["messageRate"] = it.second.messagesRate;
+            peerRates.append(peerRate);
+            downloadRate += it.second.bytesRate;
+        }
+        syncInfo["downloadRate"] = downloadRate;
+        syncInfo["peerDownloadRates"] = peerRates;
+        Json::FastWriter fastWriter;
+        return fastWriter.write(syncInfo);
+    }
+
+private:
+    void rotateWindow(std::chrono::steady_clock::time_point _now)
+    {
+        auto elapsed = _now - m_windowStartT;
+        if (elapsed < m_windowSize)
+        {
+            return;
+        }
+        auto seconds = std::chrono::duration<double>(elapsed).count();
+        for (auto it = m_peers.begin(); it != m_peers.end();)
+        {
+            auto& peer = it->second;
+            // the disconnected peers are dropped after one idle window
+            if (peer.windowMessages == 0 && peer.messagesRate == 0)
+            {
+                it = m_peers.erase(it);
+                continue;
+            }
+            peer.bytesRate = (double)peer.windowBytes / seconds;
+            peer.messagesRate = (double)peer.windowMessages / seconds;
+            peer.windowBytes = 0;
+            peer.windowMessages = 0;
+            ++it;
+        }
+        m_commitRate = (m_windowStartNumber < 0) ?
+                           0 :
+                           (double)(m_latestNumber - m_windowStartNumber) / seconds;
+        m_windowStartNumber = m_latestNumber;
+        m_windowStartT = _now;
+    }
+
+    struct PeerRate
+    {
+        uint64_t windowBytes = 0;
+        uint64_t windowMessages = 0;
+        // bytes per second
+        double bytesRate = 0;
+        double messagesRate = 0;
+    };
+
+private:
+    std::chrono::steady_clock::duration m_windowSize;
+    std::mutex m_mutex;
+    std::chrono::steady_clock::time_point m_windowStartT;
+    std::map<std::string, PeerRate> m_peers;
+    bcos::protocol::BlockNumber m_windowStartNumber = -1;
+    bcos::protocol::BlockNumber m_latestNumber = -1;
+    // blocks per second
+    double m_commitRate = 0;
+};
+}  // namespace bcos::initializer
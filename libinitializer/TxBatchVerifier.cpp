@@ -0,0 +1,175 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decode and verify the submitted transactions in batches
+ * @file TxBatchVerifier.cpp
+ * @date 2021-11-20
+ */
+#include "TxBatchVerifier.h"
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+using namespace bcos;
+using namespace bcos::initializer;
+
+TxBatchVerifier::TxBatchVerifier(
+    bcos::protocol::TransactionFactory::Ptr _txFactory, size_t _batchSize, uint64_t _batchWindow)
+  : m_txFactory(std::move(_txFactory)), m_batchSize(_batchSize), m_worker("txBatchVerify", 1)
+{
+    m_pendingTxs.reserve(m_batchSize);
+    m_batchTimer = std::make_shared<Timer>(_batchWindow, "txBatchVerify");
+    m_batchTimer->registerTimeoutHandler(boost::bind(&TxBatchVerifier::onBatchTimeout, this));
+    INITIALIZER_LOG(INFO) << LOG_DESC("TxBatchVerifier") << LOG_KV("batchSize", m_batchSize)
+                          << LOG_KV("batchWindow", _batchWindow);
+}
+
+TxBatchVerifier::Ptr TxBatchVerifier::build(
+    boost::property_tree::ptree const& _pt, bcos::protocol::TransactionFactory::Ptr _txFactory)
+{
+    // 0 means every transaction is verified on its own by the txpool
+    auto batchSize = _pt.get<size_t>("txpool.verify_batch_size", 0);
+    if (batchSize == 0)
+    {
+        return nullptr;
+    }
+    // in ms
+    auto batchWindow = _pt.get<uint64_t>("txpool.verify_batch_window", 5);
+    if (batchWindow == 0)
+    {
+        BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                  "txpool.verify_batch_window must be positive"));
+    }
+    return std::make_shared<TxBatchVerifier>(std::move(_txFactory), batchSize, batchWindow);
+}
+
+void TxBatchVerifier::start()
+{
+    if (m_batchTimer)
+    {
+        m_batchTimer->start();
+    }
+}
+
+void TxBatchVerifier::stop()
+{
+    if (m_batchTimer)
+    {
+        m_batchTimer->stop();
+    }
+}
+
+void TxBatchVerifier::asyncSubmit(
+    bcos::bytesPointer _txData, bcos::protocol::TxSubmitCallback _callback)
+{
+    PendingTxs batch;
+    std::chrono::steady_clock::time_point batchStartT;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        if (m_pendingTxs.empty())
+        {
+            m_batchStartT = std::chrono::steady_clock::now();
+        }
+        m_pendingTxs.emplace_back(std::move(_txData), std::move(_callback));
+        if (m_pendingTxs.size() < m_batchSize)
+        {
+            return;
+        }
+        std::swap(batch, m_pendingTxs);
+        m_pendingTxs.reserve(m_batchSize);
+        batchStartT = m_batchStartT;
+    }
+    dispatch(std::move(batch), batchStartT);
+}
+
+void TxBatchVerifier::onBatchTimeout()
+{
+    PendingTxs batch;
+    std::chrono::steady_clock::time_point batchStartT;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        std::swap(batch, m_pendingTxs);
+        m_pendingTxs.reserve(m_batchSize);
+        batchStartT = m_batchStartT;
+    }
+    if (!batch.empty())
+    {
+        dispatch(std::move(batch), batchStartT);
+    }
+    m_batchTimer->restart();
+}
+
+void TxBatchVerifier::dispatch(
+    PendingTxs&& _batch, std::chrono::steady_clock::time_point _batchStartT)
+{
+    m_worker.enqueue([this, batch = std::move(_batch), _batchStartT]() mutable {
+        verifyBatch(batch, _batchStartT);
+    });
+}
+
+std::vector<bcos::protocol::Transaction::Ptr> TxBatchVerifier::verifyTxs(
+    bcos::protocol::TransactionFactory::Ptr const& _txFactory,
+    std::vector<bcos::bytesPointer> const& _txsData)
+{
+    std::vector<bcos::protocol::Transaction::Ptr> txs(_txsData.size());
+    // the signature recovery dominates the decode, spread the transactions over all the cores
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _txsData.size()),
+        [&_txFactory, &_txsData, &txs](tbb::blocked_range<size_t> const& _range) {
+            for (auto i = _range.begin(); i < _range.end(); ++i)
+            {
+                try
+                {
+                    txs[i] = _txFactory->createTransaction(bcos::ref(*_txsData[i]), true);
+                }
+                catch (std::exception const&)
+                {
+                    txs[i] = nullptr;
+                }
+            }
+        });
+    return txs;
+}
+
+void TxBatchVerifier::verifyBatch(
+    PendingTxs& _batch, std::chrono::steady_clock::time_point _batchStartT)
+{
+    auto verifyStartT = std::chrono::steady_clock::now();
+    std::vector<bcos::bytesPointer> txsData;
+    txsData.reserve(_batch.size());
+    for (auto const& it : _batch)
+    {
+        txsData.emplace_back(it.first);
+    }
+    auto txs = verifyTxs(m_txFactory, txsData);
+    auto verifyEndT = std::chrono::steady_clock::now();
+    size_t invalidTxs = 0;
+    for (size_t i = 0; i < _batch.size(); ++i)
+    {
+        invalidTxs += (txs[i] == nullptr);
+        m_verifiedHandler(
+            std::move(_batch[i].first), std::move(txs[i]), std::move(_batch[i].second));
+    }
+    ++m_verifiedBatches;
+    m_verifiedTxs += _batch.size();
+    auto waitTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(verifyStartT - _batchStartT);
+    auto verifyTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(verifyEndT - verifyStartT);
+    INITIALIZER_LOG(DEBUG) << LOG_DESC("TxBatchVerifier: verifyBatch")
+                           << LOG_KV("txs", _batch.size()) << LOG_KV("invalidTxs", invalidTxs)
+                           << LOG_KV("waitTime(us)", waitTime.count())
+                           << LOG_KV("verifyTime(us)", verifyTime.count())
+                           << LOG_KV("batches", m_verifiedBatches)
+                           << LOG_KV("totalTxs", m_verifiedTxs);
+}
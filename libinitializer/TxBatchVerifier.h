@@ -0,0 +1,86 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decode and verify the submitted transactions in batches
+ * @file TxBatchVerifier.h
+ * @date 2021-11-20
+ */
+#pragma once
+#include "libinitializer/Common.h"
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+#include <bcos-framework/interfaces/protocol/TransactionFactory.h>
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <bcos-framework/libutilities/Timer.h>
+#include <chrono>
+#include <mutex>
+
+namespace bcos::initializer
+{
+class TxBatchVerifier
+{
+public:
+    using Ptr = std::shared_ptr<TxBatchVerifier>;
+    // _tx is nullptr if the transaction can't be decoded or the signature is invalid
+    using VerifiedHandler = std::function<void(bcos::bytesPointer _txData,
+        bcos::protocol::Transaction::Ptr _tx, bcos::protocol::TxSubmitCallback _callback)>;
+
+    // _batchSize: the pending transactions that trigger the verification
+    // _batchWindow: the max time in ms a transaction waits for the batch
+    TxBatchVerifier(bcos::protocol::TransactionFactory::Ptr _txFactory, size_t _batchSize,
+        uint64_t _batchWindow);
+    virtual ~TxBatchVerifier() { stop(); }
+
+    // load the [txpool] verify_batch_size, return nullptr when the batch verify is disabled
+    static TxBatchVerifier::Ptr build(boost::property_tree::ptree const& _pt,
+        bcos::protocol::TransactionFactory::Ptr _txFactory);
+
+    // decode the transactions and verify the signatures in parallel, the invalid transaction is
+    // nullptr in the result
+    static std::vector<bcos::protocol::Transaction::Ptr> verifyTxs(
+        bcos::protocol::TransactionFactory::Ptr const& _txFactory,
+        std::vector<bcos::bytesPointer> const& _txsData);
+
+    virtual void start();
+    virtual void stop();
+
+    void registerVerifiedHandler(VerifiedHandler _handler) { m_verifiedHandler = _handler; }
+
+    virtual void asyncSubmit(
+        bcos::bytesPointer _txData, bcos::protocol::TxSubmitCallback _callback);
+
+private:
+    using PendingTxs =
+        std::vector<std::pair<bcos::bytesPointer, bcos::protocol::TxSubmitCallback>>;
+    void onBatchTimeout();
+    void dispatch(PendingTxs&& _batch, std::chrono::steady_clock::time_point _batchStartT);
+    void verifyBatch(PendingTxs& _batch, std::chrono::steady_clock::time_point _batchStartT);
+
+private:
+    bcos::protocol::TransactionFactory::Ptr m_txFactory;
+    size_t m_batchSize;
+    VerifiedHandler m_verifiedHandler;
+
+    std::mutex m_mutex;
+    PendingTxs m_pendingTxs;
+    std::chrono::steady_clock::time_point m_batchStartT;
+
+    std::atomic<uint64_t> m_verifiedBatches = {0};
+    std::atomic<uint64_t> m_verifiedTxs = {0};
+
+    // the batches are verified one by one, the transactions of a batch are verified in parallel
+    bcos::ThreadPool m_worker;
+    std::shared_ptr<bcos::Timer> m_batchTimer;
+};
+}  // namespace bcos::initializer
@@ -48,12 +48,19 @@ TxPoolInitializer::TxPoolInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
 }
 
 void TxPoolInitializer::init(bcos::sealer::SealerInterface::Ptr _sealer)
+{
+    init([_sealer](size_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecv) {
+        _sealer->asyncNoteUnSealedTxsSize(_unsealedTxsSize, _onRecv);
+    });
+}
+
+void TxPoolInitializer::init(UnsealedTxsNotifier _notifier)
 {
     m_txpool->registerUnsealedTxsNotifier(
-        [_sealer](size_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecv) {
+        [_notifier](size_t _unsealedTxsSize, std::function<void(Error::Ptr)> _onRecv) {
             try
             {
-                _sealer->asyncNoteUnSealedTxsSize(_unsealedTxsSize, _onRecv);
+                _notifier(_unsealedTxsSize, _onRecv);
             }
             catch (std::exception const& e)
             {
@@ -63,6 +70,171 @@ void TxPoolInitializer::init(bcos::sealer::SealerInterface::Ptr _sealer)
             }
         });
     m_txpool->init();
+    replayJournal();
+}
+
+void TxPoolInitializer::replayJournal()
+{
+    if (!m_journal)
+    {
+        return;
+    }
+    // the signatures are verified again by the verifier workers of the txpool in parallel, the
+    // transactions committed or expired when the node is down are rejected and removed
+    auto txs = m_journal->load();
+    for (auto& tx : txs)
+    {
+        m_txpool->asyncSubmit(tx.second, [journal = m_journal, txHash = tx.first](Error::Ptr,
+                                              bcos::protocol::TransactionSubmitResult::Ptr) {
+            journal->remove(txHash);
+        });
+    }
+    INITIALIZER_LOG(INFO) << LOG_DESC("replay the txpool journal") << LOG_KV("txs", txs.size());
+}
+
+void TxPoolInitializer::setBatchVerifier(TxBatchVerifier::Ptr _batchVerifier)
+{
+    m_batchVerifier = std::move(_batchVerifier);
+    if (!m_batchVerifier)
+    {
+        return;
+    }
+    m_batchVerifier->registerVerifiedHandler(
+        [this](bcos::bytesPointer _txData, bcos::protocol::Transaction::Ptr _tx,
+            bcos::protocol::TxSubmitCallback _callback) {
+            onTxVerified(std::move(_txData), std::move(_tx), std::move(_callback));
+        });
+}
+
+void TxPoolInitializer::asyncSubmit(
+    bcos::bytesPointer _txData, bcos::protocol::TxSubmitCallback _callback)
+{
+    if (m_batchVerifier)
+    {
+        m_batchVerifier->asyncSubmit(std::move(_txData), std::move(_callback));
+        return;
+    }
+    if (!m_journal)
+    {
+        m_txpool->asyncSubmit(_txData, _callback);
+        return;
+    }
+    bcos::crypto::HashType txHash;
+    try
+    {
+        // only decode the transaction for the hash, the signature is checked by the txpool
+        auto tx = m_protocolInitializer->blockFactory()->transactionFactory()->createTransaction(
+            bcos::ref(*_txData), false);
+        txHash = tx->hash();
+    }
+    catch (std::exception const&)
+    {
+        // the invalid transaction is rejected by the txpool without being journaled
+        m_txpool->asyncSubmit(_txData, _callback);
+        return;
+    }
+    m_journal->append(txHash, bcos::ref(*_txData));
+    m_txpool->asyncSubmit(_txData, journalCallback(txHash, std::move(_callback)));
+}
+
+TxPoolInitializer::SubmitResults TxPoolInitializer::submitBatch(
+    std::vector<bcos::bytesPointer> const& _txsData)
+{
+    // Note: the group is verified as one batch, the batch verifier is bypassed
+    auto txs = TxBatchVerifier::verifyTxs(
+        m_protocolInitializer->blockFactory()->transactionFactory(), _txsData);
+    SubmitResults results;
+    results.reserve(_txsData.size());
+    size_t acceptedTxs = 0;
+    for (size_t i = 0; i < _txsData.size(); ++i)
+    {
+        if (!txs[i])
+        {
+            results.emplace_back(createSubmitResult(
+                bcos::crypto::HashType(), bcos::protocol::TransactionStatus::InvalidSignature));
+            continue;
+        }
+        auto status = admitTx(_txsData[i], txs[i], nullptr);
+        acceptedTxs += (status == bcos::protocol::TransactionStatus::None);
+        results.emplace_back(createSubmitResult(txs[i]->hash(), status));
+    }
+    INITIALIZER_LOG(DEBUG) << LOG_DESC("submitBatch") << LOG_KV("txs", _txsData.size())
+                           << LOG_KV("acceptedTxs", acceptedTxs);
+    return results;
+}
+
+void TxPoolInitializer::onTxVerified(bcos::bytesPointer _txData,
+    bcos::protocol::Transaction::Ptr _tx, bcos::protocol::TxSubmitCallback _callback)
+{
+    if (!_tx)
+    {
+        // the txpool rejects the transaction and responds the status as before
+        m_txpool->asyncSubmit(_txData, _callback);
+        return;
+    }
+    auto status = admitTx(_txData, _tx, _callback);
+    if (status == bcos::protocol::TransactionStatus::None)
+    {
+        return;
+    }
+    // the rejected transaction is never called back by the txpool
+    if (_callback)
+    {
+        _callback(BCOS_ERROR_PTR((int32_t)status, "the transaction is rejected by the txpool"),
+            createSubmitResult(_tx->hash(), status));
+    }
+}
+
+bcos::protocol::TransactionStatus TxPoolInitializer::admitTx(bcos::bytesPointer const& _txData,
+    bcos::protocol::Transaction::Ptr const& _tx, bcos::protocol::TxSubmitCallback _callback)
+{
+    // Note: submitTransaction is the entry of the txpool storage behind TxPool::asyncSubmit once
+    // the transaction is decoded, it applies the pool limit and the txValidator and keeps
+    // _callback only when the transaction is accepted, pinned by testTxPoolInitializer
+    auto txpoolStorage = m_txpool->txpoolStorage();
+    if (m_journal)
+    {
+        m_journal->append(_tx->hash(), bcos::ref(*_txData));
+        _callback = journalCallback(_tx->hash(), std::move(_callback));
+    }
+    auto status = txpoolStorage->submitTransaction(_tx, _callback);
+    if (status == bcos::protocol::TransactionStatus::None)
+    {
+        txpoolStorage->notifyUnsealedTxsSize();
+        return status;
+    }
+    // the journal entry of the rejected transaction
+    if (m_journal)
+    {
+        m_journal->remove(_tx->hash());
+    }
+    INITIALIZER_LOG(TRACE) << LOG_DESC("admitTx: reject the transaction")
+                           << LOG_KV("tx", _tx->hash().abridged())
+                           << LOG_KV("status", (int32_t)status);
+    return status;
+}
+
+bcos::protocol::TransactionSubmitResult::Ptr TxPoolInitializer::createSubmitResult(
+    bcos::crypto::HashType const& _txHash, bcos::protocol::TransactionStatus _status)
+{
+    auto result = m_protocolInitializer->txResultFactory()->createTxSubmitResult();
+    result->setTxHash(_txHash);
+    result->setStatus((uint32_t)_status);
+    return result;
+}
+
+bcos::protocol::TxSubmitCallback TxPoolInitializer::journalCallback(
+    bcos::crypto::HashType const& _txHash, bcos::protocol::TxSubmitCallback _callback)
+{
+    // the callback is called once the transaction is committed or rejected
+    return [journal = m_journal, _txHash, _callback](
+               Error::Ptr _error, bcos::protocol::TransactionSubmitResult::Ptr _result) {
+        journal->remove(_txHash);
+        if (_callback)
+        {
+            _callback(std::move(_error), std::move(_result));
+        }
+    };
 }
 
 void TxPoolInitializer::start()
@@ -75,6 +247,14 @@ void TxPoolInitializer::start()
     INITIALIZER_LOG(INFO) << LOG_DESC("Start the txpool");
     m_running = true;
     m_txpool->start();
+    if (m_journal)
+    {
+        m_journal->start();
+    }
+    if (m_batchVerifier)
+    {
+        m_batchVerifier->start();
+    }
 }
 
 void TxPoolInitializer::stop()
@@ -86,5 +266,13 @@ void TxPoolInitializer::stop()
     }
     INITIALIZER_LOG(INFO) << LOG_DESC("Stop the txpool");
     m_running = false;
+    if (m_batchVerifier)
+    {
+        m_batchVerifier->stop();
+    }
     m_txpool->stop();
+    if (m_journal)
+    {
+        m_journal->stop();
+    }
 }
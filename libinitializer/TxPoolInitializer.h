@@ -21,6 +21,8 @@
 #pragma once
 #include "Common/TarsUtils.h"
 #include "libinitializer/ProtocolInitializer.h"
+#include "libinitializer/TxBatchVerifier.h"
+#include "libinitializer/TxPoolJournal.h"
 #include <bcos-framework/interfaces/front/FrontServiceInterface.h>
 #include <bcos-framework/interfaces/ledger/LedgerInterface.h>
 #include <bcos-framework/interfaces/sealer/SealerInterface.h>
@@ -44,13 +46,46 @@ public:
         bcos::ledger::LedgerInterface::Ptr _ledger);
     virtual ~TxPoolInitializer() { stop(); }
 
+    using UnsealedTxsNotifier =
+        std::function<void(size_t _unsealedTxsSize, std::function<void(bcos::Error::Ptr)>)>;
     virtual void init(bcos::sealer::SealerInterface::Ptr _sealer);
+    // the unsealed transactions size is notified to _notifier instead of the sealer
+    virtual void init(UnsealedTxsNotifier _notifier);
     virtual void start();
     virtual void stop();
 
+    // the pending transactions are journaled and replayed in init when the journal is set
+    void setJournal(TxPoolJournal::Ptr _journal) { m_journal = std::move(_journal); }
+    // the submitted transactions are verified in batches before entering the txpool when the
+    // batch verifier is set
+    void setBatchVerifier(TxBatchVerifier::Ptr _batchVerifier);
+    // submit the transaction to the txpool, and journal it until it leaves the txpool
+    virtual void asyncSubmit(
+        bcos::bytesPointer _txData, bcos::protocol::TxSubmitCallback _callback);
+
+    using SubmitResults = std::vector<bcos::protocol::TransactionSubmitResult::Ptr>;
+    // verify the group of transactions in parallel and admit them into the txpool, the admission
+    // result of every transaction is returned in the order of _txsData without waiting for the
+    // transaction to be committed, the status None means the transaction is accepted
+    virtual SubmitResults submitBatch(std::vector<bcos::bytesPointer> const& _txsData);
+
     bcos::txpool::TxPool::Ptr txpool() { return m_txpool; }
     bcos::crypto::CryptoSuite::Ptr cryptoSuite() { return m_protocolInitializer->cryptoSuite(); }
 
+private:
+    void replayJournal();
+    // remove the transaction from the journal once it leaves the txpool
+    bcos::protocol::TxSubmitCallback journalCallback(
+        bcos::crypto::HashType const& _txHash, bcos::protocol::TxSubmitCallback _callback);
+    void onTxVerified(bcos::bytesPointer _txData, bcos::protocol::Transaction::Ptr _tx,
+        bcos::protocol::TxSubmitCallback _callback);
+    // admit the verified transaction into the txpool, _callback is only kept by the txpool when
+    // the transaction is accepted
+    bcos::protocol::TransactionStatus admitTx(bcos::bytesPointer const& _txData,
+        bcos::protocol::Transaction::Ptr const& _tx, bcos::protocol::TxSubmitCallback _callback);
+    bcos::protocol::TransactionSubmitResult::Ptr createSubmitResult(
+        bcos::crypto::HashType const& _txHash, bcos::protocol::TransactionStatus _status);
+
 private:
     bcos::tool::NodeConfig::Ptr m_nodeConfig;
     ProtocolInitializer::Ptr m_protocolInitializer;
@@ -58,6 +93,8 @@ private:
     bcos::ledger::LedgerInterface::Ptr m_ledger;
 
     bcos::txpool::TxPool::Ptr m_txpool;
+    TxPoolJournal::Ptr m_journal;
+    TxBatchVerifier::Ptr m_batchVerifier;
     std::atomic_bool m_running = {false};
 };
 }  // namespace initializer
@@ -0,0 +1,201 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the rocksDB journal of the pending transactions, replayed when the node restarts
+ * @file TxPoolJournal.cpp
+ * @date 2021-11-19
+ */
+#include "TxPoolJournal.h"
+#include <boost/filesystem.hpp>
+
+using namespace bcos;
+using namespace bcos::initializer;
+
+TxPoolJournal::TxPoolJournal(
+    std::string const& _journalPath, size_t _batchSize, uint64_t _flushInterval)
+  : m_journalPath(_journalPath), m_batchSize(std::max((size_t)1, _batchSize))
+{
+    boost::filesystem::create_directories(m_journalPath);
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    // the journal only holds the pending transactions, keep it small
+    options.write_buffer_size = 16 * 1024 * 1024;
+    options.max_write_buffer_number = 2;
+    rocksdb::DB* db;
+    auto status = rocksdb::DB::Open(options, m_journalPath, &db);
+    if (!status.ok())
+    {
+        INITIALIZER_LOG(ERROR) << LOG_DESC("open txpool journal failed")
+                               << LOG_KV("path", m_journalPath)
+                               << LOG_KV("status", status.ToString());
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(-1, "TxPoolJournal: open rocksDB failed, " + status.ToString()));
+    }
+    m_db.reset(db);
+    m_flushTimer = std::make_shared<Timer>(_flushInterval, "txpoolJournal");
+    m_flushTimer->registerTimeoutHandler(boost::bind(&TxPoolJournal::onFlushTimeout, this));
+    INITIALIZER_LOG(INFO) << LOG_DESC("TxPoolJournal") << LOG_KV("path", m_journalPath)
+                          << LOG_KV("batchSize", m_batchSize)
+                          << LOG_KV("flushInterval", _flushInterval);
+}
+
+TxPoolJournal::Ptr TxPoolJournal::build(
+    boost::property_tree::ptree const& _pt, std::string const& _basePath)
+{
+    auto journalPath = _pt.get<std::string>("txpool.journal_path", "");
+    if (journalPath.empty())
+    {
+        return nullptr;
+    }
+    if (boost::filesystem::path(journalPath).is_relative())
+    {
+        journalPath = _basePath + journalPath;
+    }
+    auto batchSize = _pt.get<size_t>("txpool.journal_batch_size", 1000);
+    // in ms
+    auto flushInterval = _pt.get<uint64_t>("txpool.journal_flush_interval", 100);
+    if (flushInterval == 0)
+    {
+        BOOST_THROW_EXCEPTION(bcos::tool::InvalidConfig() << errinfo_comment(
+                                  "txpool.journal_flush_interval must be positive"));
+    }
+    return std::make_shared<TxPoolJournal>(journalPath, batchSize, flushInterval);
+}
+
+TxPoolJournal::~TxPoolJournal()
+{
+    stop();
+}
+
+void TxPoolJournal::start()
+{
+    if (m_flushTimer)
+    {
+        m_flushTimer->start();
+    }
+}
+
+void TxPoolJournal::stop()
+{
+    if (m_flushTimer)
+    {
+        m_flushTimer->stop();
+    }
+    flush();
+}
+
+void TxPoolJournal::append(bcos::crypto::HashType const& _txHash, bcos::bytesConstRef _txData)
+{
+    bool needFlush = false;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        // the transaction is still journaled by the pending submission
+        if (++m_refCounts[_txHash] > 1)
+        {
+            return;
+        }
+        m_pendingWrites.Put(
+            rocksdb::Slice((const char*)_txHash.data(), bcos::crypto::HashType::size),
+            rocksdb::Slice((const char*)_txData.data(), _txData.size()));
+        needFlush = (++m_pendingCount >= m_batchSize);
+    }
+    if (needFlush)
+    {
+        flush();
+    }
+}
+
+void TxPoolJournal::remove(bcos::crypto::HashType const& _txHash)
+{
+    // Note: the removal is written in the same batch as the append, the order is kept
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_refCounts.find(_txHash);
+    if (it == m_refCounts.end())
+    {
+        return;
+    }
+    if (--it->second > 0)
+    {
+        return;
+    }
+    m_refCounts.erase(it);
+    m_pendingWrites.Delete(
+        rocksdb::Slice((const char*)_txHash.data(), bcos::crypto::HashType::size));
+    ++m_pendingCount;
+}
+
+size_t TxPoolJournal::refCount(bcos::crypto::HashType const& _txHash) const
+{
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_refCounts.find(_txHash);
+    return (it == m_refCounts.end()) ? 0 : it->second;
+}
+
+void TxPoolJournal::flush()
+{
+    // the batches are written one by one, an earlier batch never overwrites a later one
+    std::lock_guard<std::mutex> flushLock(m_flushMutex);
+    rocksdb::WriteBatch writes;
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        if (m_pendingCount == 0)
+        {
+            return;
+        }
+        std::swap(writes, m_pendingWrites);
+        std::swap(count, m_pendingCount);
+    }
+    // the WAL is not synced, the journal only has to survive the restart of the process
+    auto status = m_db->Write(rocksdb::WriteOptions(), &writes);
+    if (!status.ok())
+    {
+        INITIALIZER_LOG(WARNING) << LOG_DESC("TxPoolJournal: flush failed")
+                                 << LOG_KV("writes", count)
+                                 << LOG_KV("status", status.ToString());
+    }
+}
+
+std::vector<std::pair<bcos::crypto::HashType, bcos::bytesPointer>> TxPoolJournal::load()
+{
+    std::vector<std::pair<bcos::crypto::HashType, bcos::bytesPointer>> txs;
+    std::unique_ptr<rocksdb::Iterator> it(m_db->NewIterator(rocksdb::ReadOptions()));
+    for (it->SeekToFirst(); it->Valid(); it->Next())
+    {
+        auto key = it->key();
+        auto value = it->value();
+        if (key.size() != bcos::crypto::HashType::size)
+        {
+            continue;
+        }
+        txs.emplace_back(bcos::crypto::HashType((const bcos::byte*)key.data(), key.size()),
+            std::make_shared<bcos::bytes>(value.data(), value.data() + value.size()));
+    }
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        for (auto const& tx : txs)
+        {
+            ++m_refCounts[tx.first];
+        }
+    }
+    INITIALIZER_LOG(INFO) << LOG_DESC("TxPoolJournal: load") << LOG_KV("txs", txs.size());
+    return txs;
+}
+
+void TxPoolJournal::onFlushTimeout()
+{
+    flush();
+    m_flushTimer->restart();
+}
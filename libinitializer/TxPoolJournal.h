@@ -0,0 +1,89 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the rocksDB journal of the pending transactions, replayed when the node restarts
+ * @file TxPoolJournal.h
+ * @date 2021-11-19
+ */
+#pragma once
+#include "libinitializer/Common.h"
+#include <bcos-framework/interfaces/crypto/CommonType.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Timer.h>
+#include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace bcos::initializer
+{
+class TxPoolJournal
+{
+public:
+    using Ptr = std::shared_ptr<TxPoolJournal>;
+    // _batchSize: the pending writes that trigger the flush before the flush interval expires
+    TxPoolJournal(std::string const& _journalPath, size_t _batchSize, uint64_t _flushInterval);
+    virtual ~TxPoolJournal();
+
+    // load the [txpool] journal_path, return nullptr when the journal is disabled
+    // _basePath: the prefix of the relative journal path
+    static TxPoolJournal::Ptr build(
+        boost::property_tree::ptree const& _pt, std::string const& _basePath);
+
+    virtual void start();
+    virtual void stop();
+
+    // the writes are buffered and flushed in batches, a crash loses at most the last batch
+    // Note: the same transaction may be submitted again while it's pending, every append is
+    // paired with a remove, the transaction is removed from the journal with the last remove
+    virtual void append(bcos::crypto::HashType const& _txHash, bcos::bytesConstRef _txData);
+    virtual void remove(bcos::crypto::HashType const& _txHash);
+    // the submissions of the journaled transaction not removed yet
+    size_t refCount(bcos::crypto::HashType const& _txHash) const;
+    virtual void flush();
+
+    // all the flushed transactions, must be called before the new transactions are appended,
+    // every loaded transaction is removed with one remove
+    virtual std::vector<std::pair<bcos::crypto::HashType, bcos::bytesPointer>> load();
+
+private:
+    void onFlushTimeout();
+
+    // the hashes are uniformly distributed, the leading bytes are a good enough hash
+    struct TxHashHasher
+    {
+        size_t operator()(bcos::crypto::HashType const& _txHash) const
+        {
+            size_t hash;
+            std::memcpy(&hash, _txHash.data(), sizeof(hash));
+            return hash;
+        }
+    };
+
+private:
+    std::string m_journalPath;
+    size_t m_batchSize;
+    std::unique_ptr<rocksdb::DB> m_db;
+
+    mutable std::mutex m_mutex;
+    rocksdb::WriteBatch m_pendingWrites;
+    size_t m_pendingCount = 0;
+    std::unordered_map<bcos::crypto::HashType, size_t, TxHashHasher> m_refCounts;
+    std::mutex m_flushMutex;
+
+    std::shared_ptr<bcos::Timer> m_flushTimer;
+};
+}  // namespace bcos::initializer
@@ -0,0 +1,389 @@
+#include "libinitializer/ExecutorInitializer.h"
+#include "libinitializer/ParallelExecutor.h"
+#include "libinitializer/ProtocolInitializer.h"
+#include "libinitializer/SchedulerInitializer.h"
+#include <bcos-executor/LRUStorage.h>
+#include <bcos-framework/interfaces/consensus/ConsensusNode.h>
+#include <bcos-framework/interfaces/executor/PrecompiledTypeDef.h>
+#include <bcos-framework/interfaces/ledger/LedgerConfig.h>
+#include <bcos-framework/libcodec/abi/ContractABICodec.h>
+#include <bcos-framework/libexecutor/NativeExecutionMessage.h>
+#include <bcos-ledger/libledger/Ledger.h>
+#include <bcos-scheduler/ExecutorManager.h>
+#include <bcos-storage/RocksDBStorage.h>
+#include <rocksdb/db.h>
+#include <rocksdb/env.h>
+#include <tbb/task_group.h>
+#include <boost/algorithm/hex.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+// count the allocations of the whole benchmark binary, the replaced operator new forwards to
+// malloc, which is the tcmalloc linked into the benchmark as into the node binaries;
+// the array and nothrow forms of the standard library call into this one
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t _size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(_size ? _size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _ptr) noexcept
+{
+    std::free(_ptr);
+}
+
+void operator delete(void* _ptr, std::size_t) noexcept
+{
+    std::free(_ptr);
+}
+
+namespace bcos::test
+{
+// a contract without abi that increases the slot 0 on every call:
+// init: PUSH1 0x0a PUSH1 0x0c PUSH1 0x00 CODECOPY PUSH1 0x0a PUSH1 0x00 RETURN
+// runtime: PUSH1 0x00 SLOAD PUSH1 0x01 ADD PUSH1 0x00 SSTORE STOP
+static const char* counterBin = "600a600c600039600a6000f360005460010160005500";
+
+struct BenchmarkNode
+{
+    std::unique_ptr<rocksdb::Env> memEnv;
+    bcos::storage::TransactionalStorageInterface::Ptr storage;
+    std::shared_ptr<bcos::ledger::Ledger> ledger;
+    bcos::scheduler::SchedulerInterface::Ptr scheduler;
+    protocol::BlockNumber blockNumber = 0;
+};
+
+// the executor configs the workloads run on, the first is the serial reference
+struct ExecutorSetting
+{
+    std::string taskScheduler;
+    size_t workerNum;
+};
+
+struct StageStatistics
+{
+    std::string name;
+    std::vector<uint64_t> latencies;
+
+    void record(std::chrono::steady_clock::time_point _startT)
+    {
+        latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - _startT)
+                                .count());
+    }
+    uint64_t total() const { return std::accumulate(latencies.begin(), latencies.end(), 0ul); }
+    uint64_t max() const
+    {
+        return latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end());
+    }
+    uint64_t avg() const { return latencies.empty() ? 0 : total() / latencies.size(); }
+};
+
+struct SchedulerExecutorFixture
+{
+    SchedulerExecutorFixture()
+    {
+        m_protocolInitializer = std::make_shared<initializer::ProtocolInitializer>();
+        m_protocolInitializer->init(std::make_shared<tool::NodeConfig>(
+            std::make_shared<bcos::crypto::KeyFactoryImpl>()));
+        m_keyPair = m_protocolInitializer->cryptoSuite()->signatureImpl()->generateKeyPair();
+    }
+
+    // the whole node runs over a rocksDB in memory, nothing is written to the disk
+    std::shared_ptr<BenchmarkNode> createNode(ExecutorSetting const& _setting)
+    {
+        auto node = std::make_shared<BenchmarkNode>();
+        node->memEnv.reset(rocksdb::NewMemEnv(rocksdb::Env::Default()));
+        rocksdb::Options options;
+        options.env = node->memEnv.get();
+        options.create_if_missing = true;
+        rocksdb::DB* db;
+        auto status = rocksdb::DB::Open(options, "/benchmark", &db);
+        BOOST_REQUIRE_MESSAGE(status.ok(), status.ToString());
+        node->storage =
+            std::make_shared<bcos::storage::RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db));
+
+        auto blockFactory = m_protocolInitializer->blockFactory();
+        auto hashImpl = m_protocolInitializer->cryptoSuite()->hashImpl();
+        auto ledger = std::make_shared<bcos::ledger::Ledger>(blockFactory, node->storage);
+        node->ledger = ledger;
+        auto ledgerConfig = std::make_shared<bcos::ledger::LedgerConfig>();
+        ledgerConfig->setConsensusNodeList(
+            {std::make_shared<bcos::consensus::ConsensusNode>(m_keyPair->publicKey(), 1)});
+        ledgerConfig->setBlockTxCountLimit(c_blockTxCount);
+        ledgerConfig->setLeaderSwitchPeriod(1);
+        ledgerConfig->setConsensusTimeout(3000);
+        ledger->buildGenesisBlock(ledgerConfig, 3000000000, "benchmark");
+
+        auto executionMessageFactory = std::make_shared<executor::NativeExecutionMessageFactory>();
+        auto executorManager = std::make_shared<bcos::scheduler::ExecutorManager>();
+        node->scheduler = initializer::SchedulerInitializer::build(executorManager, ledger,
+            node->storage, executionMessageFactory, blockFactory,
+            m_protocolInitializer->txResultFactory(), hashImpl, false);
+
+        auto cache = std::make_shared<bcos::executor::LRUStorage>(node->storage);
+        cache->start();
+        // the blocks carry the whole transactions, the executor never fetches them from txpool
+        auto executor = initializer::ExecutorInitializer::build(
+            nullptr, cache, node->storage, executionMessageFactory, hashImpl, false, false);
+        auto config = std::make_shared<initializer::ParallelExecutorConfig>();
+        config->taskScheduler = _setting.taskScheduler;
+        config->workerNum = _setting.workerNum;
+        executorManager->addExecutor(
+            "default", std::make_shared<initializer::ParallelExecutor>(executor, config));
+        return node;
+    }
+
+    protocol::Transaction::Ptr createTransaction(std::string const& _to, bytes const& _input)
+    {
+        return m_protocolInitializer->blockFactory()->transactionFactory()->createTransaction(0,
+            _to, _input, u256(++m_nonce), 500, "chain0", "group0", utcTime(), m_keyPair);
+    }
+
+    protocol::Block::Ptr createBlock(
+        BenchmarkNode& _node, std::vector<protocol::Transaction::Ptr> const& _txs)
+    {
+        auto block = m_protocolInitializer->blockFactory()->createBlock();
+        block->blockHeader()->setNumber(++_node.blockNumber);
+        for (auto const& tx : _txs)
+        {
+            block->appendTransaction(tx);
+        }
+        return block;
+    }
+
+    // return the state root of the committed block
+    crypto::HashType executeAndCommit(BenchmarkNode& _node, protocol::Block::Ptr _block,
+        StageStatistics* _execute = nullptr, StageStatistics* _commit = nullptr)
+    {
+        auto startT = std::chrono::steady_clock::now();
+        std::promise<protocol::BlockHeader::Ptr> executedHeader;
+        _node.scheduler->executeBlock(
+            _block, false, [&](Error::Ptr&& _error, protocol::BlockHeader::Ptr&& _header) {
+                BOOST_CHECK_MESSAGE(!_error, (_error ? _error->errorMessage() : ""));
+                executedHeader.set_value(std::move(_header));
+            });
+        auto header = executedHeader.get_future().get();
+        BOOST_REQUIRE(header);
+        BOOST_REQUIRE_EQUAL(header->number(), _block->blockHeader()->number());
+        if (_execute)
+        {
+            _execute->record(startT);
+        }
+
+        startT = std::chrono::steady_clock::now();
+        std::promise<void> committed;
+        _node.scheduler->commitBlock(
+            header, [&](Error::Ptr&& _error, bcos::ledger::LedgerConfig::Ptr&&) {
+                BOOST_CHECK_MESSAGE(!_error, (_error ? _error->errorMessage() : ""));
+                committed.set_value();
+            });
+        committed.get_future().get();
+        if (_commit)
+        {
+            _commit->record(startT);
+        }
+        BOOST_REQUIRE_EQUAL(latestBlockNumber(_node), header->number());
+        BOOST_REQUIRE_EQUAL(_block->receiptsSize(), _block->transactionsSize());
+        size_t failedTxs = 0;
+        for (size_t i = 0; i < _block->receiptsSize(); ++i)
+        {
+            failedTxs += (_block->receipt(i)->status() != 0);
+        }
+        BOOST_CHECK_EQUAL(failedTxs, 0);
+        return header->stateRoot();
+    }
+
+    protocol::BlockNumber latestBlockNumber(BenchmarkNode& _node)
+    {
+        std::promise<protocol::BlockNumber> blockNumber;
+        _node.ledger->asyncGetBlockNumber(
+            [&](Error::Ptr _error, protocol::BlockNumber _blockNumber) {
+                BOOST_CHECK_MESSAGE(!_error, (_error ? _error->errorMessage() : ""));
+                blockNumber.set_value(_blockNumber);
+            });
+        return blockNumber.get_future().get();
+    }
+
+    // run the measured blocks on the node of every setting, _setup: the txs of the blocks
+    // committed before the measurement
+    void runWorkload(std::string const& _name,
+        std::vector<std::vector<protocol::Transaction::Ptr>> const& _setup,
+        std::vector<std::vector<protocol::Transaction::Ptr>> const& _blocks)
+    {
+        std::vector<crypto::HashType> serialStateRoots;
+        for (auto const& setting : c_settings)
+        {
+            auto node = createNode(setting);
+            for (auto const& txs : _setup)
+            {
+                executeAndCommit(*node, createBlock(*node, txs));
+            }
+            auto stateRoots = measureBlocks(_name, setting, *node, _blocks);
+            if (serialStateRoots.empty())
+            {
+                serialStateRoots = std::move(stateRoots);
+                continue;
+            }
+            // the parallel execution must reach the states of the serial execution
+            BOOST_CHECK_EQUAL(stateRoots.size(), serialStateRoots.size());
+            for (size_t i = 0; i < std::min(stateRoots.size(), serialStateRoots.size()); ++i)
+            {
+                BOOST_CHECK_MESSAGE(stateRoots[i] == serialStateRoots[i],
+                    _name << ": the state root of block " << i << " with "
+                          << setting.taskScheduler << " differs from the serial execution");
+            }
+        }
+    }
+
+    std::vector<crypto::HashType> measureBlocks(std::string const& _name,
+        ExecutorSetting const& _setting, BenchmarkNode& _node,
+        std::vector<std::vector<protocol::Transaction::Ptr>> const& _blocks)
+    {
+        StageStatistics build{"build"};
+        StageStatistics execute{"execute"};
+        StageStatistics commit{"commit"};
+        std::vector<protocol::Block::Ptr> blocks;
+        for (auto const& txs : _blocks)
+        {
+            auto startT = std::chrono::steady_clock::now();
+            blocks.emplace_back(createBlock(_node, txs));
+            build.record(startT);
+        }
+
+        std::vector<crypto::HashType> stateRoots;
+        auto allocationsStart = g_allocations.load();
+        for (auto& block : blocks)
+        {
+            stateRoots.emplace_back(executeAndCommit(_node, block, &execute, &commit));
+        }
+        auto allocations = g_allocations.load() - allocationsStart;
+
+        size_t txCount = 0;
+        for (auto const& txs : _blocks)
+        {
+            txCount += txs.size();
+        }
+        auto totalTime = execute.total() + commit.total();
+        std::stringstream stream;
+        stream << std::fixed << std::setprecision(2) << "[Benchmark] workload=" << _name
+               << ", scheduler=" << _setting.taskScheduler
+               << ", workers=" << _setting.workerNum << ", blocks=" << _blocks.size()
+               << ", txs=" << txCount
+               << ", tps=" << (totalTime ? (double)txCount * 1000000 / totalTime : 0)
+               << ", allocationsPerTx=" << (txCount ? (double)allocations / txCount : 0);
+        for (auto const* stage : {&build, &execute, &commit})
+        {
+            stream << ", " << stage->name << "(avg/max us)=" << stage->avg() << "/"
+                   << stage->max();
+        }
+        BOOST_TEST_MESSAGE(stream.str());
+        return stateRoots;
+    }
+
+    // the transfers between the disjoint accounts of the DAG transfer precompiled are executed
+    // in parallel by the DAG
+    void transferWorkload()
+    {
+        codec::abi::ContractABICodec abi(m_protocolInitializer->cryptoSuite()->hashImpl());
+        std::vector<protocol::Transaction::Ptr> setup;
+        for (size_t i = 0; i < c_blockTxCount * 2; ++i)
+        {
+            setup.emplace_back(createTransaction(precompiled::DAG_TRANSFER_ADDRESS,
+                abi.abiIn("userAdd(string,uint256)", "user" + std::to_string(i),
+                    u256(c_blockCount * c_blockTxCount))));
+        }
+
+        std::vector<std::vector<protocol::Transaction::Ptr>> blocks(c_blockCount);
+        for (auto& txs : blocks)
+        {
+            for (size_t i = 0; i < c_blockTxCount; ++i)
+            {
+                txs.emplace_back(createTransaction(precompiled::DAG_TRANSFER_ADDRESS,
+                    abi.abiIn("userTransfer(string,string,uint256)",
+                        "user" + std::to_string(i * 2), "user" + std::to_string(i * 2 + 1),
+                        u256(1))));
+            }
+        }
+        runWorkload("transfer", {setup}, blocks);
+    }
+
+    // _contractNum: 1 for the calls all conflicting on the same contract, the calls to the
+    // different contracts have no conflict
+    void callWorkload(std::string const& _name, size_t _contractNum)
+    {
+        bytes code;
+        boost::algorithm::unhex(std::string(counterBin), std::back_inserter(code));
+        std::vector<protocol::Transaction::Ptr> deploys;
+        for (size_t i = 0; i < _contractNum; ++i)
+        {
+            deploys.emplace_back(createTransaction("", code));
+        }
+        // the addresses of the deployed contracts are the same on every node
+        auto node = createNode(c_settings.front());
+        auto deployBlock = createBlock(*node, deploys);
+        executeAndCommit(*node, deployBlock);
+        std::vector<std::string> contracts;
+        for (size_t i = 0; i < deployBlock->receiptsSize(); ++i)
+        {
+            contracts.emplace_back(deployBlock->receipt(i)->contractAddress());
+        }
+        BOOST_REQUIRE_EQUAL(contracts.size(), _contractNum);
+
+        std::vector<std::vector<protocol::Transaction::Ptr>> blocks(c_blockCount);
+        for (auto& txs : blocks)
+        {
+            for (size_t i = 0; i < c_blockTxCount; ++i)
+            {
+                txs.emplace_back(createTransaction(contracts[i % _contractNum], bytes()));
+            }
+        }
+        runWorkload(_name, {deploys}, blocks);
+    }
+
+    const size_t c_blockCount = 10;
+    const size_t c_blockTxCount = 1000;
+    const size_t c_contractNum = 64;
+    const std::vector<ExecutorSetting> c_settings = {{"pool", 1},
+        {"pool", std::thread::hardware_concurrency()}, {"tbb", std::thread::hardware_concurrency()}};
+
+    initializer::ProtocolInitializer::Ptr m_protocolInitializer;
+    bcos::crypto::KeyPairInterface::Ptr m_keyPair;
+    uint64_t m_nonce = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(BenchmarkSchedulerExecutor, SchedulerExecutorFixture)
+
+BOOST_AUTO_TEST_CASE(transfer)
+{
+    transferWorkload();
+}
+
+BOOST_AUTO_TEST_CASE(conflictCall)
+{
+    callWorkload("conflictCall", 1);
+}
+
+BOOST_AUTO_TEST_CASE(nonConflictCall)
+{
+    callWorkload("nonConflictCall", c_contractNum);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
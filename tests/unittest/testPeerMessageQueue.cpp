@@ -0,0 +1,129 @@
+#include "libinitializer/PeerMessageQueue.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <future>
+#include <numeric>
+#include <thread>
+
+namespace bcos::test
+{
+struct PeerMessageQueueFixture
+{
+    PeerMessageQueueFixture() : keyFactory(std::make_shared<crypto::KeyFactoryImpl>()) {}
+
+    crypto::NodeIDPtr createNodeID(byte _seed)
+    {
+        bytes nodeID(64, _seed);
+        return keyFactory->createKey(nodeID);
+    }
+
+    // wait at most 10s for the messages handled by the workers
+    void waitFor(std::function<bool()> _condition)
+    {
+        for (size_t i = 0; i < 1000 && !_condition(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        BOOST_REQUIRE(_condition());
+    }
+
+    crypto::KeyFactory::Ptr keyFactory;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestPeerMessageQueue, PeerMessageQueueFixture)
+
+BOOST_AUTO_TEST_CASE(fifoPerPeer)
+{
+    // the workers outnumber the peers, the messages of a peer must still be handled in order
+    initializer::PeerMessageQueue queue("fifo", 8, 0, 10000);
+    std::vector<crypto::NodeIDPtr> peers = {createNodeID(1), createNodeID(2)};
+    std::mutex mutex;
+    std::vector<std::vector<size_t>> handled(peers.size());
+    std::vector<std::atomic<size_t>> running(peers.size());
+    std::atomic<bool> overlapped = {false};
+    const size_t messages = 1000;
+    for (size_t i = 0; i < messages; ++i)
+    {
+        for (size_t p = 0; p < peers.size(); ++p)
+        {
+            queue.enqueue(peers[p], [&, p, i]() {
+                // the messages of the different peers overlap, but never those of one peer
+                if (running[p]++ > 0)
+                {
+                    overlapped = true;
+                }
+                {
+                    std::lock_guard<std::mutex> l(mutex);
+                    handled[p].push_back(i);
+                }
+                --running[p];
+            });
+        }
+    }
+    waitFor([&]() {
+        std::lock_guard<std::mutex> l(mutex);
+        return handled[0].size() == messages && handled[1].size() == messages;
+    });
+    BOOST_CHECK(!overlapped);
+    for (auto const& order : handled)
+    {
+        BOOST_CHECK(std::is_sorted(order.begin(), order.end()));
+    }
+    BOOST_CHECK_EQUAL(queue.droppedMessages(), 0);
+    BOOST_CHECK_EQUAL(queue.pendingMessages(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(dropOldestAndCongestion)
+{
+    const size_t capacity = 10;
+    initializer::PeerMessageQueue queue("drop", 1, 0, capacity);
+    auto peer = createNodeID(1);
+    auto otherPeer = createNodeID(2);
+
+    // block the only worker with the first message
+    std::promise<void> blocked;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    std::mutex mutex;
+    std::vector<size_t> handled;
+    queue.enqueue(peer, [&]() {
+        blocked.set_value();
+        releaseFuture.wait();
+    });
+    blocked.get_future().wait();
+    BOOST_CHECK(!queue.congested(peer));
+
+    // the peer floods 5 messages beyond the capacity, the oldest 5 are dropped
+    for (size_t i = 0; i < capacity + 5; ++i)
+    {
+        queue.enqueue(peer, [&, i]() {
+            std::lock_guard<std::mutex> l(mutex);
+            handled.push_back(i);
+        });
+    }
+    std::atomic<bool> otherHandled = {false};
+    queue.enqueue(otherPeer, [&]() { otherHandled = true; });
+    BOOST_CHECK_EQUAL(queue.droppedMessages(), 5);
+    BOOST_CHECK_EQUAL(queue.pendingMessages(), capacity + 1);
+    BOOST_CHECK(queue.congested(peer));
+    // the other peer only sheds its own messages
+    BOOST_CHECK(!queue.congested(otherPeer));
+
+    release.set_value();
+    waitFor([&]() {
+        std::lock_guard<std::mutex> l(mutex);
+        return handled.size() == capacity;
+    });
+    waitFor([&]() { return otherHandled.load(); });
+    BOOST_CHECK_EQUAL(queue.pendingMessages(), 0);
+    std::vector<size_t> expected(capacity);
+    std::iota(expected.begin(), expected.end(), 5);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        handled.begin(), handled.end(), expected.begin(), expected.end());
+    // the congestion is cleared once the queue is drained
+    BOOST_CHECK(!queue.congested(peer));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
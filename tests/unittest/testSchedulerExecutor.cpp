@@ -1,3 +1,18 @@
+#include "libinitializer/ExecutorInitializer.h"
+#include "libinitializer/ParallelExecutor.h"
+#include "libinitializer/ProtocolInitializer.h"
+#include "libinitializer/SchedulerInitializer.h"
+#include <bcos-executor/LRUStorage.h>
+#include <bcos-framework/interfaces/consensus/ConsensusNode.h>
+#include <bcos-framework/interfaces/executor/PrecompiledTypeDef.h>
+#include <bcos-framework/interfaces/ledger/LedgerConfig.h>
+#include <bcos-framework/libcodec/abi/ContractABICodec.h>
+#include <bcos-framework/libexecutor/NativeExecutionMessage.h>
+#include <bcos-ledger/libledger/Ledger.h>
+#include <bcos-scheduler/ExecutorManager.h>
+#include <bcos-storage/RocksDBStorage.h>
+#include <rocksdb/db.h>
+#include <rocksdb/env.h>
 #include <tbb/task_group.h>
 #include <boost/test/unit_test.hpp>
 #include <filesystem>
@@ -7,12 +22,143 @@ namespace bcos::test
 {
 struct SchedulerExecutorFixture
 {
-    SchedulerExecutorFixture() {}
+    SchedulerExecutorFixture()
+    {
+        m_protocolInitializer = std::make_shared<initializer::ProtocolInitializer>();
+        m_protocolInitializer->init(std::make_shared<tool::NodeConfig>(
+            std::make_shared<bcos::crypto::KeyFactoryImpl>()));
+        m_keyPair = m_protocolInitializer->cryptoSuite()->signatureImpl()->generateKeyPair();
+
+        // the node runs over a rocksDB in memory, nothing is written to the disk
+        m_memEnv.reset(rocksdb::NewMemEnv(rocksdb::Env::Default()));
+        rocksdb::Options options;
+        options.env = m_memEnv.get();
+        options.create_if_missing = true;
+        rocksdb::DB* db;
+        auto status = rocksdb::DB::Open(options, "/testSchedulerExecutor", &db);
+        BOOST_REQUIRE_MESSAGE(status.ok(), status.ToString());
+        m_storage =
+            std::make_shared<bcos::storage::RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db));
+
+        auto blockFactory = m_protocolInitializer->blockFactory();
+        auto hashImpl = m_protocolInitializer->cryptoSuite()->hashImpl();
+        m_ledger = std::make_shared<bcos::ledger::Ledger>(blockFactory, m_storage);
+        auto ledgerConfig = std::make_shared<bcos::ledger::LedgerConfig>();
+        ledgerConfig->setConsensusNodeList(
+            {std::make_shared<bcos::consensus::ConsensusNode>(m_keyPair->publicKey(), 1)});
+        ledgerConfig->setBlockTxCountLimit(1000);
+        ledgerConfig->setLeaderSwitchPeriod(1);
+        ledgerConfig->setConsensusTimeout(3000);
+        m_ledger->buildGenesisBlock(ledgerConfig, 3000000000, "testSchedulerExecutor");
+
+        auto executionMessageFactory = std::make_shared<executor::NativeExecutionMessageFactory>();
+        auto executorManager = std::make_shared<bcos::scheduler::ExecutorManager>();
+        m_scheduler = initializer::SchedulerInitializer::build(executorManager, m_ledger,
+            m_storage, executionMessageFactory, blockFactory,
+            m_protocolInitializer->txResultFactory(), hashImpl, false);
+
+        auto cache = std::make_shared<bcos::executor::LRUStorage>(m_storage);
+        cache->start();
+        // the blocks carry the whole transactions, the executor never fetches them from txpool
+        auto executor = initializer::ExecutorInitializer::build(
+            nullptr, cache, m_storage, executionMessageFactory, hashImpl, false, false);
+        auto config = std::make_shared<initializer::ParallelExecutorConfig>();
+        config->taskScheduler = "pool";
+        config->workerNum = 2;
+        executorManager->addExecutor(
+            "default", std::make_shared<initializer::ParallelExecutor>(executor, config));
+    }
+
+    protocol::Transaction::Ptr createTransaction(std::string const& _to, bytes const& _input)
+    {
+        return m_protocolInitializer->blockFactory()->transactionFactory()->createTransaction(0,
+            _to, _input, u256(++m_nonce), 500, "chain0", "group0", utcTime(), m_keyPair);
+    }
+
+    protocol::Block::Ptr executeAndCommit(std::vector<protocol::Transaction::Ptr> const& _txs)
+    {
+        auto block = m_protocolInitializer->blockFactory()->createBlock();
+        block->blockHeader()->setNumber(++m_blockNumber);
+        for (auto const& tx : _txs)
+        {
+            block->appendTransaction(tx);
+        }
+
+        std::promise<protocol::BlockHeader::Ptr> executedHeader;
+        m_scheduler->executeBlock(
+            block, false, [&](Error::Ptr&& _error, protocol::BlockHeader::Ptr&& _header) {
+                BOOST_CHECK_MESSAGE(!_error, (_error ? _error->errorMessage() : ""));
+                executedHeader.set_value(std::move(_header));
+            });
+        auto header = executedHeader.get_future().get();
+        BOOST_REQUIRE(header);
+        BOOST_CHECK_EQUAL(header->number(), m_blockNumber);
+
+        std::promise<void> committed;
+        m_scheduler->commitBlock(
+            header, [&](Error::Ptr&& _error, bcos::ledger::LedgerConfig::Ptr&&) {
+                BOOST_CHECK_MESSAGE(!_error, (_error ? _error->errorMessage() : ""));
+                committed.set_value();
+            });
+        committed.get_future().get();
+        return block;
+    }
+
+    protocol::BlockNumber latestBlockNumber()
+    {
+        std::promise<protocol::BlockNumber> blockNumber;
+        m_ledger->asyncGetBlockNumber([&](Error::Ptr _error, protocol::BlockNumber _blockNumber) {
+            BOOST_CHECK_MESSAGE(!_error, (_error ? _error->errorMessage() : ""));
+            blockNumber.set_value(_blockNumber);
+        });
+        return blockNumber.get_future().get();
+    }
+
+    void checkReceipts(protocol::Block::Ptr const& _block)
+    {
+        BOOST_REQUIRE_EQUAL(_block->receiptsSize(), _block->transactionsSize());
+        for (size_t i = 0; i < _block->receiptsSize(); ++i)
+        {
+            BOOST_CHECK_EQUAL(_block->receipt(i)->status(), 0);
+        }
+    }
+
+    initializer::ProtocolInitializer::Ptr m_protocolInitializer;
+    bcos::crypto::KeyPairInterface::Ptr m_keyPair;
+    std::unique_ptr<rocksdb::Env> m_memEnv;
+    bcos::storage::TransactionalStorageInterface::Ptr m_storage;
+    std::shared_ptr<bcos::ledger::Ledger> m_ledger;
+    bcos::scheduler::SchedulerInterface::Ptr m_scheduler;
+    protocol::BlockNumber m_blockNumber = 0;
+    uint64_t m_nonce = 0;
 };
 
 BOOST_FIXTURE_TEST_SUITE(TestSchedulerExecutor, SchedulerExecutorFixture)
 
-BOOST_AUTO_TEST_CASE(parallelExecutor) {}
+BOOST_AUTO_TEST_CASE(parallelExecutor)
+{
+    const size_t userCount = 8;
+    codec::abi::ContractABICodec abi(m_protocolInitializer->cryptoSuite()->hashImpl());
+    std::vector<protocol::Transaction::Ptr> addUsers;
+    for (size_t i = 0; i < userCount; ++i)
+    {
+        addUsers.emplace_back(createTransaction(precompiled::DAG_TRANSFER_ADDRESS,
+            abi.abiIn("userAdd(string,uint256)", "user" + std::to_string(i), u256(100))));
+    }
+    checkReceipts(executeAndCommit(addUsers));
+    BOOST_CHECK_EQUAL(latestBlockNumber(), 1);
+
+    // the transfers between the disjoint accounts are executed in parallel by the DAG
+    std::vector<protocol::Transaction::Ptr> transfers;
+    for (size_t i = 0; i < userCount / 2; ++i)
+    {
+        transfers.emplace_back(createTransaction(precompiled::DAG_TRANSFER_ADDRESS,
+            abi.abiIn("userTransfer(string,string,uint256)", "user" + std::to_string(i * 2),
+                "user" + std::to_string(i * 2 + 1), u256(1))));
+    }
+    checkReceipts(executeAndCommit(transfers));
+    BOOST_CHECK_EQUAL(latestBlockNumber(), 2);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
-}  // namespace bcos::test
\ No newline at end of file
+}  // namespace bcos::test
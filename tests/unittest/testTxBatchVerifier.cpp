@@ -0,0 +1,66 @@
+#include "libinitializer/TxBatchVerifier.h"
+#include <bcos-crypto/encrypt/AESCrypto.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-framework/interfaces/crypto/CryptoSuite.h>
+#include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
+#include <boost/test/unit_test.hpp>
+
+namespace bcos::test
+{
+struct TxBatchVerifierFixture
+{
+    TxBatchVerifierFixture()
+    {
+        auto cryptoSuite = std::make_shared<crypto::CryptoSuite>(
+            std::make_shared<crypto::Keccak256>(), std::make_shared<crypto::Secp256k1Crypto>(),
+            std::make_shared<crypto::AESCrypto>());
+        keyPair = cryptoSuite->signatureImpl()->generateKeyPair();
+        txFactory = std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite);
+    }
+
+    bytesPointer createTx(u256 const& _nonce)
+    {
+        bytes input = {0x01, 0x02, 0x03};
+        auto tx = txFactory->createTransaction(
+            0, "", input, _nonce, 500, "chain0", "group0", utcTime(), keyPair);
+        auto encodedData = tx->encode();
+        return std::make_shared<bytes>(encodedData.begin(), encodedData.end());
+    }
+
+    crypto::KeyPairInterface::Ptr keyPair;
+    protocol::TransactionFactory::Ptr txFactory;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTxBatchVerifier, TxBatchVerifierFixture)
+
+BOOST_AUTO_TEST_CASE(verifyTxs)
+{
+    std::vector<bytesPointer> txsData;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        txsData.emplace_back(createTx(i));
+    }
+    // the undecodable transaction
+    txsData[10] = std::make_shared<bytes>(32, 0xff);
+    txsData[20] = std::make_shared<bytes>();
+
+    auto txs = initializer::TxBatchVerifier::verifyTxs(txFactory, txsData);
+    BOOST_CHECK_EQUAL(txs.size(), txsData.size());
+    BOOST_CHECK(!txs[10]);
+    BOOST_CHECK(!txs[20]);
+    for (size_t i = 0; i < txs.size(); ++i)
+    {
+        if (i == 10 || i == 20)
+        {
+            continue;
+        }
+        // the results are in the order of the submitted transactions
+        BOOST_REQUIRE(txs[i]);
+        BOOST_CHECK_EQUAL(txs[i]->nonce(), u256(i));
+    }
+    BOOST_CHECK(initializer::TxBatchVerifier::verifyTxs(txFactory, {}).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -0,0 +1,112 @@
+#include "libinitializer/TxPoolJournal.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <boost/test/unit_test.hpp>
+#include <filesystem>
+
+namespace bcos::test
+{
+struct TxPoolJournalFixture
+{
+    TxPoolJournalFixture()
+    {
+        journalPath = (std::filesystem::temp_directory_path() /
+                       ("txpoolJournal" + std::to_string(utcTime())))
+                          .string();
+    }
+    ~TxPoolJournalFixture() { std::filesystem::remove_all(journalPath); }
+
+    // the journal flushes every write, the timer is never started
+    std::shared_ptr<initializer::TxPoolJournal> openJournal()
+    {
+        return std::make_shared<initializer::TxPoolJournal>(journalPath, 1, 100);
+    }
+
+    std::pair<crypto::HashType, bytes> createTx(std::string const& _data)
+    {
+        bytes txData(_data.begin(), _data.end());
+        return std::make_pair(hashImpl.hash(bcos::ref(txData)), txData);
+    }
+
+    std::map<crypto::HashType, bytes> loadTxs()
+    {
+        auto journal = openJournal();
+        std::map<crypto::HashType, bytes> txs;
+        for (auto const& tx : journal->load())
+        {
+            txs.emplace(tx.first, *tx.second);
+        }
+        return txs;
+    }
+
+    std::string journalPath;
+    crypto::Keccak256 hashImpl;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTxPoolJournal, TxPoolJournalFixture)
+
+BOOST_AUTO_TEST_CASE(appendRemoveAndReplay)
+{
+    auto tx1 = createTx("tx1");
+    auto tx2 = createTx("tx2");
+    auto tx3 = createTx("tx3");
+    {
+        auto journal = openJournal();
+        BOOST_CHECK(journal->load().empty());
+        journal->append(tx1.first, bcos::ref(tx1.second));
+        journal->append(tx2.first, bcos::ref(tx2.second));
+        journal->append(tx3.first, bcos::ref(tx3.second));
+        journal->remove(tx2.first);
+        journal->stop();
+    }
+    auto txs = loadTxs();
+    BOOST_CHECK_EQUAL(txs.size(), 2);
+    BOOST_CHECK(txs.at(tx1.first) == tx1.second);
+    BOOST_CHECK(txs.at(tx3.first) == tx3.second);
+    BOOST_CHECK(!txs.count(tx2.first));
+
+    // the replayed transactions are removed once they leave the txpool
+    {
+        auto journal = openJournal();
+        auto replayedTxs = journal->load();
+        BOOST_CHECK_EQUAL(replayedTxs.size(), 2);
+        for (auto const& tx : replayedTxs)
+        {
+            BOOST_CHECK_EQUAL(journal->refCount(tx.first), 1);
+            journal->remove(tx.first);
+        }
+        journal->stop();
+    }
+    BOOST_CHECK(loadTxs().empty());
+}
+
+BOOST_AUTO_TEST_CASE(duplicateSubmission)
+{
+    auto tx = createTx("tx");
+    {
+        auto journal = openJournal();
+        journal->load();
+        journal->append(tx.first, bcos::ref(tx.second));
+        // the resubmission of the pending transaction is rejected as already in txpool
+        journal->append(tx.first, bcos::ref(tx.second));
+        journal->remove(tx.first);
+        BOOST_CHECK_EQUAL(journal->refCount(tx.first), 1);
+        journal->stop();
+    }
+    // the first submission is still journaled
+    BOOST_CHECK_EQUAL(loadTxs().size(), 1);
+    {
+        auto journal = openJournal();
+        journal->load();
+        // replayed and resubmitted by the client again
+        journal->append(tx.first, bcos::ref(tx.second));
+        journal->remove(tx.first);
+        BOOST_CHECK_EQUAL(journal->refCount(tx.first), 1);
+        journal->remove(tx.first);
+        BOOST_CHECK_EQUAL(journal->refCount(tx.first), 0);
+        journal->stop();
+    }
+    BOOST_CHECK(loadTxs().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
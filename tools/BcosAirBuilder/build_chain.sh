@@ -718,20 +718,88 @@ generate_common_ini() {
 [consensus]
     ; min block generation time(ms)
     min_seal_time=500
+    ; the proposals sealed and agreed on ahead of the committed block, 0 keeps the default
+    ; pipeline_depth=0
+    ; size the blocks by the unsealed txs, the execution time and the consensus round trip,
+    ; min_seal_time becomes the max wait, false seals every min_seal_time
+    ; adaptive_seal=false
 
 [executor]
     ; use the wasm virtual machine or not
     is_wasm=${wasm_mode}
     is_auth_check=${auth_mode}
     auth_admin_account=${auth_admin_account}
+    ; the executor threads, 0 means the number of cpus
+    ; worker_num=0
+    ; the backend of the executor threads: pool(FIFO thread pool) or tbb(work-stealing)
+    ; task_scheduler=pool
+    ; bind the executor threads to the cpus, e.g. 0-3,8, the tbb workers are only bound while
+    ; running the executor tasks
+    ; cpu_affinity=
+    ; bind the executor threads to the cpus of the numa node
+    ; numa_node=
+    ; the lower priority threads of the read-only call, getCode and getHash requests
+    ; call_worker_num=
+    ; the max pending read-only requests, the exceeded requests are rejected
+    ; call_queue_limit=10000
+    ; the in-process executors, only 1 is supported now
+    ; executor_num=1
 
 [storage]
     data_path=data
+    ; the rocksDB tuning profile: low_memory(~64MB), balanced(~320MB) or high_throughput(~1GB)
+    profile=balanced
+    ; override the profile, sizes in MB
+    ; block_cache_size=128
+    ; write_buffer_size=64
+    ; max_write_buffer_number=3
+    ; max_background_jobs=4
+    ; bloom_filter=true
+    ; build the bloom filters on the table name of the keys as well, the scans across the tables
+    ; stop at the end of the first table once it's on, the existing data files get the filter
+    ; when they are compacted
+    ; table_prefix_bloom=false
+    ; level or universal
+    ; compaction_style=level
+    ; the rocksDB pipelined write, only helps the concurrent writers, the blocks are committed serially
+    ; pipelined_write=false
+    ; sync the data files and the WAL in the background every bytes_per_sync KB, smooths the fsync I/O
+    ; bytes_per_sync=1024
+    ; run the compactions with a lower cpu priority than the executor
+    ; low_priority_compaction=false
+    ; the memory(MB) shared by the memtables, the rocksDB block cache and the executor cache,
+    ; overrides block_cache_size, 0 means no limit
+    ; memory_budget=0
+    ; the ratio of the executor cache after the memtables are subtracted from the memory_budget
+    ; executor_cache_ratio=0.3
+    ; write a rocksDB checkpoint of the state and the blocks to the path when the node starts
+    ; snapshot_export_path=
+    ; start an empty node from the checkpoint, the blocks after it are synced from the peers
+    ; the checkpoint must be exported by a node of the same chain, group and genesis
+    ; snapshot_import_path=
 
 [txpool]
     limit=15000
     notify_worker_num=2
     verify_worker_num=2
+    ; journal the pending transactions and replay them when the node restarts, disabled if empty
+    ; journal_path=data/txpool_journal
+    ; the pending journal writes flushed in one batch
+    ; journal_batch_size=1000
+    ; ms
+    ; journal_flush_interval=100
+    ; verify the submitted transactions in batches of verify_batch_size, disabled if 0
+    ; verify_batch_size=0
+    ; ms, the max time a transaction waits for the batch
+    ; verify_batch_window=5
+
+[front]
+    ; the threads dispatching the inbound messages of each module, the consensus messages are
+    ; dispatched in order by one thread before the sync messages
+    ; block_sync_worker_num=1
+    ; txs_sync_worker_num=1
+    ; the pending txsSync messages of one peer, the oldest are dropped when the queue is full
+    ; txs_sync_peer_queue_size=1000
 [log]
     enable=true
     log_path=./log